@@ -48,6 +48,52 @@ static inline void Draw_Line(int x0, int y0, int x1, int y1, int r, int g, int b
     nextpri += sizeof(LINE_F2);
 }
 
+// Sets the texture page for the sprites drawn after it
+static inline void Draw_TexPage(int tpage_id, int z_index) {
+    DR_TPAGE *tpage = (DR_TPAGE *)nextpri;
+    SetDrawTPage(tpage, 0, 1, tpage_id);
+    addPrim(ot[db][z_index], tpage);
+    nextpri += sizeof(DR_TPAGE);
+}
+
+// Sprites use the current texture page, see Draw_TexPage
+static inline void Draw_Sprite16(int x, int y, int u, int v, int clut, int semi_trans, int z_index) {
+    SPRT_16 *sprt = (SPRT_16 *)nextpri;
+    setSprt16(sprt);
+    setXY0(sprt, x, y);
+    setUV0(sprt, u, v);
+    sprt->clut = clut;
+    setRGB0(sprt, 128, 128, 128);
+    setSemiTrans(sprt, semi_trans);
+    addPrim(ot[db][z_index], sprt);
+    nextpri += sizeof(SPRT_16);
+}
+
+static inline void Draw_Sprite8(int x, int y, int u, int v, int clut, int semi_trans, int z_index) {
+    SPRT_8 *sprt = (SPRT_8 *)nextpri;
+    setSprt8(sprt);
+    setXY0(sprt, x, y);
+    setUV0(sprt, u, v);
+    sprt->clut = clut;
+    setRGB0(sprt, 128, 128, 128);
+    setSemiTrans(sprt, semi_trans);
+    addPrim(ot[db][z_index], sprt);
+    nextpri += sizeof(SPRT_8);
+}
+
+static inline void Draw_SpriteWH(int x, int y, int u, int v, int w, int h, int clut, int semi_trans, int z_index) {
+    SPRT *sprt = (SPRT *)nextpri;
+    setSprt(sprt);
+    setXY0(sprt, x, y);
+    setUV0(sprt, u, v);
+    setWH(sprt, w, h);
+    sprt->clut = clut;
+    setRGB0(sprt, 128, 128, 128);
+    setSemiTrans(sprt, semi_trans);
+    addPrim(ot[db][z_index], sprt);
+    nextpri += sizeof(SPRT);
+}
+
 static inline void Draw_Sprite(int x, int y, int u, int v, int w, int h, int tpage_id, int z_index) {
     POLY_FT4 *poly = (POLY_FT4 *)nextpri;
     setPolyFT4(poly);
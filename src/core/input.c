@@ -23,6 +23,8 @@ static unsigned short getMaskForAction(GameBinding bind) {
         case ROTATE_CCW: return PAD_CIRCLE;
         case CONFIRM: return PAD_START | PAD_CROSS;
         case CANCEL: return PAD_TRIANGLE;
+        case TURBO: return PAD_SELECT;
+        case REWIND: return PAD_L1;
         default: return 0;
     }
 }
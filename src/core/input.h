@@ -9,7 +9,9 @@ typedef enum {
     ROTATE_CW,
     ROTATE_CCW,
     CONFIRM,
-    CANCEL
+    CANCEL,
+    TURBO,
+    REWIND
 } GameBinding;
 
 void Input_Init(void);
@@ -0,0 +1,103 @@
+#include "jobs.h"
+#include "perf.h"
+#include "system.h"
+#include <stddef.h>
+
+#define DISPLAY_MARGIN_LINES 16 // Slack for a frame that builds slower than the last
+
+#define MAX_REPORTED_JOBS 8
+
+static Job *activeJobs = NULL;
+static u_int frameCount = 0;
+
+// Jobs seen so far, for Jobs_Print
+static Job *reportedJobs[MAX_REPORTED_JOBS];
+static int reportedCount = 0;
+
+static void report(Job *job) {
+    for (int i = 0; i < reportedCount; i++) {
+        if (reportedJobs[i] == job) return;
+    }
+    if (reportedCount < MAX_REPORTED_JOBS) reportedJobs[reportedCount++] = job;
+}
+
+void Jobs_Start(Job *job) {
+    if (job->running) return;
+
+    job->resume = 0;
+    job->running = 1;
+    job->cpuTicks = 0;
+    job->slices = 0;
+    job->framesSpanned = 0;
+    job->startFrame = frameCount;
+
+    job->next = activeJobs;
+    activeJobs = job;
+    report(job);
+}
+
+void Jobs_Cancel(Job *job) {
+    for (Job **link = &activeJobs; *link; link = &(*link)->next) {
+        if (*link == job) {
+            *link = job->next;
+            job->running = 0;
+            return;
+        }
+    }
+}
+
+static int linesLeft(void) {
+    return System_LinesToSwap() - DISPLAY_MARGIN_LINES;
+}
+
+// Round robin, one slice per job per pass, until the frame is used up
+// or every job has spent its own budget
+void Jobs_Run(void) {
+    frameCount++;
+
+    for (Job *job = activeJobs; job; job = job->next) {
+        job->frameTicks = 0;
+    }
+
+    int ran = 1;
+    while (ran && linesLeft() > 0) {
+        Job **link = &activeJobs;
+        ran = 0;
+
+        while (*link && linesLeft() > 0) {
+            Job *job = *link;
+            if (job->frameBudget && job->frameTicks >= job->frameBudget) {
+                link = &job->next;
+                continue;
+            }
+
+            u_short start = Perf_Now();
+            int result = job->run(job);
+            u_short spent = Perf_Since(start);
+            job->cpuTicks += spent;
+            job->frameTicks += spent;
+            job->slices++;
+            ran = 1;
+            job->framesSpanned = frameCount - job->startFrame;
+
+            if (result == JOB_DONE) {
+                *link = job->next;
+                job->running = 0;
+            } else {
+                link = &job->next;
+            }
+        }
+    }
+}
+
+void Jobs_Print(void) {
+    for (int i = 0; i < reportedCount; i++) {
+        const Job *job = reportedJobs[i];
+
+        // Whole milliseconds first, so long running jobs do not overflow
+        u_long us = (job->cpuTicks / PERF_TICKS_PER_MS) * 1000 +
+                    (job->cpuTicks % PERF_TICKS_PER_MS) * 1000 / PERF_TICKS_PER_MS;
+        FntPrint("%s: %luus %d frames%s\n", job->name, us, job->framesSpanned,
+                 job->running ? " ..." : "");
+    }
+}
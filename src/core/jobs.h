@@ -0,0 +1,58 @@
+#ifndef CORE_JOBS_H
+#define CORE_JOBS_H
+
+#include <sys/types.h>
+
+// Cooperative jobs for work longer than a frame. A job is a function that
+// picks up where it left off, protothread style: its body sits between
+// JOB_BEGIN and JOB_END and it gives the CPU back with JOB_YIELD. Locals
+// do not survive a yield, keep state in the job's data.
+//
+//   static int countJob(Job *job) {
+//       Counter *c = job->data;
+//       JOB_BEGIN(job);
+//       for (c->i = 0; c->i < 1000; c->i++) {
+//           work(c->i);
+//           JOB_YIELD(job);
+//       }
+//       JOB_END(job);
+//   }
+#define JOB_YIELDED 0
+#define JOB_DONE    1
+
+#define JOB_BEGIN(job) switch ((job)->resume) { case 0:
+#define JOB_YIELD(job) do { (job)->resume = __LINE__; return JOB_YIELDED; case __LINE__:; } while (0)
+#define JOB_END(job)   } (job)->resume = 0; return JOB_DONE
+
+typedef struct Job Job;
+typedef int (*JobFunc)(Job *job);
+
+struct Job {
+    const char *name;
+    JobFunc run;
+    void *data;
+
+    int resume; // Line to continue from, 0 before the first slice
+    int running;
+    u_short frameBudget; // Root counter 2 ticks it may use per frame, 0 for no cap
+
+    // Stats of the current or last run
+    u_long cpuTicks;      // Root counter 2 ticks spent inside the job
+    u_short slices;       // Times it was resumed
+    u_short framesSpanned;
+    u_int startFrame;     // Frame count before its first slice
+    u_long frameTicks;    // Spent in the current frame
+
+    Job *next;
+};
+
+void Jobs_Start(Job *job); // Job memory belongs to the caller
+void Jobs_Cancel(Job *job);
+
+// Runs jobs until the next frame has no time left, call after System_Display
+// so the GPU draws while they run
+void Jobs_Run(void);
+
+void Jobs_Print(void); // Stats of every job started so far
+
+#endif
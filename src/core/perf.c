@@ -0,0 +1,7 @@
+#include "perf.h"
+
+void Perf_Init(void) {
+    // Free running, the target only sets the wrap point
+    SetRCnt(RCntCNT2, 0xffff, RCntMdNOINTR);
+    StartRCnt(RCntCNT2);
+}
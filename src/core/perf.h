@@ -0,0 +1,26 @@
+#ifndef CORE_PERF_H
+#define CORE_PERF_H
+
+#include <sys/types.h>
+#include <libapi.h>
+
+// Build with PERF_HUD=1 (make CPPFLAGS+=-DPERF_HUD=1) to print timings on screen
+#ifndef PERF_HUD
+#define PERF_HUD 0
+#endif
+
+// Root counter 2 runs at System Clock / 8
+#define PERF_TICKS_PER_MS 4234
+
+void Perf_Init(void);
+
+// 16-bit free running count, wraps roughly every 15ms
+static inline u_short Perf_Now(void) {
+    return (u_short)GetRCnt(RCntCNT2);
+}
+
+static inline u_short Perf_Since(u_short start) {
+    return (u_short)(Perf_Now() - start);
+}
+
+#endif
@@ -5,6 +5,7 @@ typedef void (*StateFunc)(void);
 
 static StateFunc _currentInit = NULL;
 static StateFunc _currentUpdate = NULL;
+static StateFunc _currentDraw = NULL;
 static StateFunc _currentExit = NULL;
 
 static GameState _nextState = STATE_BOOT;
@@ -19,21 +20,37 @@ static void setupStatePointers(GameState state) {
         case STATE_TITLE:
             _currentInit = StateTitle_Init;
             _currentUpdate = StateTitle_Update;
+            _currentDraw = StateTitle_Draw;
             _currentExit = StateTitle_Exit;
             break;
         case STATE_ARCADE:
             _currentInit = StateArcade_Init;
             _currentUpdate = StateArcade_Update;
+            _currentDraw = StateArcade_Draw;
+            _currentExit = StateArcade_Exit;
+            break;
+        case STATE_REPLAY:
+            _currentInit = StateArcade_InitReplay;
+            _currentUpdate = StateArcade_Update;
+            _currentDraw = StateArcade_Draw;
+            _currentExit = StateArcade_Exit;
+            break;
+        case STATE_ATTRACT:
+            _currentInit = StateArcade_InitAttract;
+            _currentUpdate = StateArcade_Update;
+            _currentDraw = StateArcade_Draw;
             _currentExit = StateArcade_Exit;
             break;
         case STATE_GAMEOVER:
             _currentInit = StateGameover_Init;
             _currentUpdate = StateGameover_Update;
+            _currentDraw = StateGameover_Draw;
             _currentExit = StateGameover_Exit;
             break;
         default:
             _currentInit = NULL;
             _currentUpdate = NULL;
+            _currentDraw = NULL;
             _currentExit = NULL;
             break;
     }
@@ -58,6 +75,10 @@ void StateManager_Update() {
     if (_currentUpdate != NULL) _currentUpdate();
 }
 
+void StateManager_Draw() {
+    if (_currentDraw != NULL) _currentDraw();
+}
+
 void StateManager_ChangeState(GameState newState) {
     _nextState = newState;
     _pendingChange = 1;
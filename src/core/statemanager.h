@@ -6,11 +6,14 @@ typedef enum {
     STATE_TITLE,
     STATE_ARCADE,
     STATE_GAMEOVER,
+    STATE_REPLAY,
+    STATE_ATTRACT,
     STATE_PAUSE
 } GameState;
 
 void StateManager_Init(void);
 void StateManager_Update(void);
+void StateManager_Draw(void);
 void StateManager_ChangeState(GameState newState);
 
 #endif
@@ -1,6 +1,11 @@
 #include "system.h"
+#include "perf.h"
 
-#define VMODE 0 // 0: NTSC, 1: PAL
+// Region byte of the BIOS version string, 'E' on European consoles
+#define BIOS_REGION ((volatile char *)0xBFC7FF52)
+
+static int videoMode = MODE_NTSC;
+static int refreshRate = 60;
 
 // Double buffered DISPENV and DRAWENV
 DISPENV disp[2];
@@ -19,9 +24,51 @@ char *nextpri = primbuff[0];
 // Current buffer index
 short db = 0;
 
+// Fixed rate logic clock, counted by the VSync interrupt
+#define MAX_CATCHUP_TICKS 15 // Longer stalls (loading, debugger) are dropped
+#define TURBO_FRAME_TICKS 12 // Uncapped turbo draws a frame every 200ms
+
+static volatile u_long tickCount = 0;
+static int tickPhase = 0;
+static u_long consumedTicks = 0;
+static FrameStats frameStats;
+static int turbo = TURBO_OFF;
+static int buildStartLine = 0;
+
+// Line the GPU last went idle on, the queue also drains between the
+// environment, font and OT submissions so this is only read once
+// DrawSync says the whole frame is done
+static volatile int gpuDoneLine = 0;
+
+// Ticks per second measurement window
+static int windowClockTicks = 0;
+static int windowLogicTicks = 0;
+
+// Each blank is worth TICKS_PER_SECOND / refreshRate ticks, kept as an
+// exact fraction: PAL yields 6 ticks every 5 blanks and never drifts
+static void onVSync(void) {
+    tickPhase += TICKS_PER_SECOND;
+    while (tickPhase >= refreshRate) {
+        tickPhase -= refreshRate;
+        tickCount++;
+    }
+}
+
+static void onDrawDone(void) {
+    gpuDoneLine = VSync(1);
+}
+
 void System_Init(void) {
+    // Match the console's video standard
+    if (*BIOS_REGION == 'E') {
+        videoMode = MODE_PAL;
+        refreshRate = 50;
+    }
+    SetVideoMode(videoMode);
+
     // Reset GPU
     ResetGraph(0);
+    DrawSyncCallback(onDrawDone);
 
     // Define display environments
     SetDefDispEnv(&disp[0], 0, 0, SCREENXRES, SCREENYRES);
@@ -29,8 +76,8 @@ void System_Init(void) {
     SetDefDrawEnv(&draw[0], 0, SCREENYRES, SCREENXRES, SCREENYRES);
     SetDefDrawEnv(&draw[1], 0, 0, SCREENXRES, SCREENYRES);
 
-    if (VMODE) {
-        SetVideoMode(MODE_PAL);
+    if (videoMode == MODE_PAL) {
+        // Center the 240 lines in the taller PAL picture
         disp[0].screen.y += 8;
         disp[1].screen.y += 8;
     }
@@ -41,7 +88,7 @@ void System_Init(void) {
     setRGB0(&draw[0], 19, 19, 19);
     setRGB0(&draw[1], 19, 19, 19);
 
-    // Enable background clearing
+    // Enable background clearing, see System_SetClear
     draw[0].isbg = 1;
     draw[1].isbg = 1;
 
@@ -52,6 +99,74 @@ void System_Init(void) {
     // Load standard font
     FntLoad(960, 0);
     FntOpen(32, 20, 260, 200, 0, 512);
+
+    Perf_Init();
+
+    consumedTicks = tickCount;
+    VSyncCallback(onVSync);
+}
+
+int System_WaitTicks(void) {
+    u_long elapsed;
+
+    // Rendering faster than the tick rate, wait for the next one
+    while ((elapsed = tickCount - consumedTicks) == 0);
+
+    consumedTicks += elapsed;
+    buildStartLine = VSync(1);
+    if (elapsed > MAX_CATCHUP_TICKS) {
+        frameStats.droppedTicks += elapsed - MAX_CATCHUP_TICKS;
+        elapsed = MAX_CATCHUP_TICKS;
+    }
+
+    frameStats.renders++;
+    frameStats.skippedRenders += elapsed - 1;
+    frameStats.lastTicks = elapsed;
+
+    windowClockTicks += elapsed;
+    if (windowClockTicks >= TICKS_PER_SECOND) {
+        frameStats.ticksPerSecond = (windowLogicTicks * TICKS_PER_SECOND) / windowClockTicks;
+        windowClockTicks = 0;
+        windowLogicTicks = 0;
+    }
+
+    return elapsed;
+}
+
+// Uncapped turbo keeps running logic until this says a frame is due
+int System_FrameDue(void) {
+    return tickCount - consumedTicks >= TURBO_FRAME_TICKS;
+}
+
+void System_CountTick(void) {
+    frameStats.ticks++;
+    windowLogicTicks++;
+}
+
+int System_IsPAL(void) {
+    return videoMode == MODE_PAL;
+}
+
+int System_FrameLines(void) {
+    return (videoMode == MODE_PAL) ? LINES_PAL : LINES_NTSC;
+}
+
+// Time to spare before the next swap, keeping what the last frame took
+// to build in reserve for the next one
+int System_LinesToSwap(void) {
+    return System_FrameLines() - VSync(1) - frameStats.cpuLines;
+}
+
+const FrameStats *System_GetFrameStats(void) {
+    return &frameStats;
+}
+
+void System_SetTurbo(int multiplier) {
+    turbo = multiplier;
+}
+
+int System_GetTurbo(void) {
+    return turbo;
 }
 
 void System_ClearOT(void) {
@@ -59,13 +174,32 @@ void System_ClearOT(void) {
     ClearOTagR(ot[db], OTLEN);
 }
 
+void System_SetClear(int enabled) {
+    draw[0].isbg = enabled;
+    draw[1].isbg = enabled;
+}
+
+// The GPU draws frame N while the CPU builds frame N + 1 into the other
+// buffer. Both only meet here: frame N must be finished before it is shown,
+// and frame N + 1 is submitted right after the swap.
 void System_Display(void) {
+    int frameLines = System_FrameLines();
+    int built = VSync(1);
+
     // Wait for GPU to finish
     DrawSync(0);
+    int ready = VSync(1);
 
     // Wait for V-Blank
     VSync(0);
 
+    // Lines are counted from the last blank, longer stretches are clamped
+    frameStats.cpuLines = (built >= buildStartLine) ? built - buildStartLine : built;
+    frameStats.gpuWaitLines = ready - built;
+    frameStats.vsyncWaitLines = (ready < frameLines) ? frameLines - ready : 0;
+    frameStats.gpuLines = gpuDoneLine;
+    frameStats.gpuIdleLines = (gpuDoneLine < frameLines) ? frameLines - gpuDoneLine : 0;
+
     // Swap buffers
     PutDispEnv(&disp[db]);
     PutDrawEnv(&draw[db]);
@@ -73,7 +207,7 @@ void System_Display(void) {
     // Flush debug text buffer
     FntFlush(-1);
 
-    // Send OT to GPU
+    // Send OT to GPU, the callback stamps the line it finishes on
     DrawOTag(&ot[db][OTLEN - 1]);
 
     // Flip index
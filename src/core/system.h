@@ -18,10 +18,54 @@
 extern u_long ot[2][OTLEN];
 extern char *nextpri;
 extern short db;
+extern DRAWENV draw[2];
+
+// Logic runs at a fixed tick rate on both 50Hz and 60Hz displays, so all
+// gameplay timing is written in milliseconds and converted at compile time
+#define TICKS_PER_SECOND 60
+#define MS_TO_TICKS(ms) (((ms) * TICKS_PER_SECOND + 500) / 1000)
+
+// Scanlines per frame, VSync(1) counts them since the last blank
+#define LINES_NTSC 263
+#define LINES_PAL  313
+
+// Logic and render counts since boot
+typedef struct {
+    u_long ticks;          // Logic ticks run
+    u_long renders;        // Frames drawn
+    u_long skippedRenders; // Clock ticks that had no frame of their own
+    u_long droppedTicks;   // Clock ticks lost to stalls longer than the catch-up limit
+    int lastTicks;         // Clock ticks elapsed before the last frame
+    int ticksPerSecond;    // Logic ticks run over the last second of real time
+
+    // Last frame's CPU/GPU overlap, in scanlines
+    int cpuLines;       // Logic and packet building, from the tick to System_Display
+    int gpuLines;       // Drawing the previous frame, from submission to completion
+    int gpuWaitLines;   // CPU waiting for the GPU to finish
+    int vsyncWaitLines; // CPU waiting for the blank
+    int gpuIdleLines;   // GPU waiting for the next frame
+} FrameStats;
+
+// Turbo runs several logic ticks per clock tick, for soak tests and demos
+#define TURBO_OFF      1
+#define TURBO_UNCAPPED 0 // As many ticks as fit, drawing a few frames a second
 
 // System API
 void System_Init(void);
 void System_ClearOT(void);
 void System_Display(void);
+void System_SetClear(int enabled); // Off when something covers every pixel each frame
+
+// Blocks until at least one clock tick is due, returns how many are
+int System_WaitTicks(void);
+int System_FrameDue(void);
+void System_CountTick(void);
+int System_IsPAL(void);
+int System_FrameLines(void);
+int System_LinesToSwap(void); // Scanlines free before the next frame is due
+const FrameStats *System_GetFrameStats(void);
+
+void System_SetTurbo(int multiplier);
+int System_GetTurbo(void);
 
 #endif
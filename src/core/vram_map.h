@@ -7,4 +7,19 @@
 #define TEX_BG_RIGHT_X   512
 #define TEX_BG_RIGHT_Y   0
 
+// Background, grid and lines composited once, copied to every frame
+#define TEX_BACKDROP_X   320
+#define TEX_BACKDROP_Y   256
+
+// Settled cells of the board, 16bpp with clear texels where cells are empty
+#define TEX_BOARD_CACHE_X 640
+#define TEX_BOARD_CACHE_Y 256
+
+// 4bpp block atlas and its CLUT, rewritten by Grid_SetTheme
+#define TEX_BLOCKS_X     704
+#define TEX_BLOCKS_Y     0
+
+#define CLUT_BLOCKS_X    704
+#define CLUT_BLOCKS_Y    16
+
 #endif
@@ -0,0 +1,31 @@
+#include "checksum.h"
+#include <stdio.h>
+
+_Static_assert((CHECKSUM_RING_SIZE & (CHECKSUM_RING_SIZE - 1)) == 0, "CHECKSUM_RING_SIZE must be a power of two");
+
+// Checksums of the most recent ticks, indexed by tick
+static u_int ring[CHECKSUM_RING_SIZE];
+static u_int tick = 0;
+
+void Checksum_Reset(void) {
+    tick = 0;
+}
+
+void Checksum_Record(u_int checksum) {
+    ring[tick & (CHECKSUM_RING_SIZE - 1)] = checksum;
+
+#if CHECKSUM_TTY >= 2
+    printf("%u %08x\n", tick, checksum);
+#endif
+
+    tick++;
+}
+
+// One "tick checksum" line per recorded tick, oldest first
+void Checksum_Dump(void) {
+    u_int first = (tick > CHECKSUM_RING_SIZE) ? tick - CHECKSUM_RING_SIZE : 0;
+
+    for (u_int t = first; t < tick; t++) {
+        printf("%u %08x\n", t, ring[t & (CHECKSUM_RING_SIZE - 1)]);
+    }
+}
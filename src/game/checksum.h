@@ -0,0 +1,19 @@
+#ifndef GAME_CHECKSUM_H
+#define GAME_CHECKSUM_H
+
+#include <sys/types.h>
+
+// Build with CHECKSUM_TTY=1 to dump the ring over TTY at game over, or 2 to
+// print every tick as it happens (make CPPFLAGS+=-DCHECKSUM_TTY=2). Two
+// builds fed the same replay can then be diffed line by line.
+#ifndef CHECKSUM_TTY
+#define CHECKSUM_TTY 0
+#endif
+
+#define CHECKSUM_RING_SIZE 256 // Power of two
+
+void Checksum_Reset(void);
+void Checksum_Record(u_int checksum);
+void Checksum_Dump(void);
+
+#endif
@@ -0,0 +1,38 @@
+#include "events.h"
+
+#define EVENT_INDEX_MASK (EVENT_CAPACITY - 1)
+
+_Static_assert((EVENT_CAPACITY & EVENT_INDEX_MASK) == 0, "EVENT_CAPACITY must be a power of two");
+_Static_assert(EVENT_CAPACITY < 256, "Ring indices are bytes");
+
+void Events_Clear(EventRing *ring) {
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+}
+
+// Full ring keeps the oldest events, the new one is counted and dropped
+void Events_Push(EventRing *ring, int type, int x, int value) {
+    u_char next = (ring->tail + 1) & EVENT_INDEX_MASK;
+
+    if (next == ring->head) {
+        ring->dropped++;
+        return;
+    }
+
+    GameEvent *event = &ring->events[ring->tail];
+    event->type = type;
+    event->x = x;
+    event->pad = 0;
+    event->value = value;
+    ring->tail = next;
+}
+
+// Returns 0 once the ring is empty
+int Events_Pop(EventRing *ring, GameEvent *event) {
+    if (ring->head == ring->tail) return 0;
+
+    *event = ring->events[ring->head];
+    ring->head = (ring->head + 1) & EVENT_INDEX_MASK;
+    return 1;
+}
@@ -0,0 +1,37 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include "../core/system.h"
+
+// What the game logic did, queued for presentation, sound and telemetry so
+// they can react without rescanning the board every frame.
+typedef enum {
+    EVENT_PIECE_LANDED,   // x: column, value: row
+    EVENT_SQUARES_FORMED, // x: leftmost column validated, value: new squares
+    EVENT_COLUMN_SWEPT,   // x: column, value: cells erased
+    EVENT_PASS_COMPLETE,  // value: squares scored by the pass
+    EVENT_GAME_OVER,      // value: final score
+} GameEventType;
+
+typedef struct {
+    u_char type;
+    signed char x;
+    short pad;
+    int value;
+} GameEvent;
+
+// Fixed capacity, no allocation. Plain data so it is copied with the board.
+#define EVENT_CAPACITY 32 // Power of two
+
+typedef struct {
+    GameEvent events[EVENT_CAPACITY];
+    u_char head; // Next event to read
+    u_char tail; // Next free slot
+    u_short dropped; // Events lost to a full ring
+} EventRing;
+
+void Events_Clear(EventRing *ring);
+void Events_Push(EventRing *ring, int type, int x, int value);
+int Events_Pop(EventRing *ring, GameEvent *event);
+
+#endif
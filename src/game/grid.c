@@ -1,5 +1,6 @@
 #include "grid.h"
 #include "../core/gpu_prims.h"
+#include "../core/perf.h"
 #include "player.h"
 #include "theme.h"
 
@@ -8,45 +9,193 @@
 #include "../assets/bg_right.h"
 #include "../core/vram_map.h"
 
-#define TOTAL_CELLS (GRID_W * GRID_H)
 #define COLOR_GRID_LINES 40, 42, 44
 #define COLOR_GRID_BG 0, 0, 0
-#define GRAVITY_DELAY_FRAMES 3
+#define GRAVITY_DELAY_TICKS MS_TO_TICKS(50)
 
-typedef struct {
-  unsigned char type;   // 0: Empty; 1: Color A; 2: Color B;
-  unsigned char marked; // 0: Unmarked; 1: Marked;
-  unsigned char protected; // 0: Not protected for timeline; 1: Protected for timeline;
-} BlockData;
-
-// State
-static BlockData board[GRID_H][GRID_W];
-static int gridOffsetX = CENTERX;
-static int gridOffsetY = CENTERY;
+#define COLUMN_MASK ((1 << GRID_H) - 1)
+
+// Board center on screen
+#define GRID_OFFSET_X CENTERX
+#define GRID_OFFSET_Y CENTERY
+
+// Presentation State (shared by every board)
 static TIM_IMAGE bgLeftInfo;
 static TIM_IMAGE bgRightInfo;
 static int currentThemeIndex = 0;
 
-static CVECTOR BLOCK_PALETTE_LIGHT[3];
-static CVECTOR BLOCK_PALETTE_DARK[3];
+// Block atlas: every look of every block color is a 4bpp cell, so a block
+// is one sprite and a theme is one 16 color CLUT. Cells are BLOCK_SIZE
+// squares on a 16 texel pitch, five looks per color, followed by the
+// half size queue cells on an 8 texel pitch.
+#define ATLAS_W 192 // Texels, four per VRAM word
+#define ATLAS_H 16
+#define ATLAS_CELL 16
+#define ATLAS_QUEUE_CELL 8
+
+#define BLOCK_STYLE_NORMAL 0
+#define BLOCK_STYLE_MARKED 1
+#define BLOCK_STYLE_GHOST  2
+
+#define CHAIN_MARK_SIZE (BLOCK_SIZE / 4)
+#define QUEUE_BLOCK_SIZE (BLOCK_SIZE / 2)
+
+// Looks are the block styles, plus chain marked normal and marked blocks
+#define LOOK_CHAIN  3 // Added to the normal and marked looks
+#define BLOCK_LOOKS 5
+#define ATLAS_QUEUE_U (2 * BLOCK_LOOKS * ATLAS_CELL)
+
+// CLUT entries, three per block color
+#define INK_CLEAR 0
+#define INK_LIGHT(color) (1 + ((color) - 1) * 3)
+#define INK_DARK(color)  (INK_LIGHT(color) + 1)
+#define INK_GHOST(color) (INK_LIGHT(color) + 2) // Dark with the STP bit set
+#define INK_WHITE 7
+
+#define BLOCK_CLUT getClut(CLUT_BLOCKS_X, CLUT_BLOCKS_Y)
+#define BLOCK_TPAGE getTPage(0, 0, TEX_BLOCKS_X, TEX_BLOCKS_Y)
+
+static u_short atlasTexels[ATLAS_H][ATLAS_W / 4];
+static u_short blockClut[16];
+
+// Background sprites, grid backdrop and grid lines never change during a
+// game. They are drawn once into VRAM and copied into each frame.
+static RECT backdropRect = {TEX_BACKDROP_X, TEX_BACKDROP_Y, SCREENXRES, SCREENYRES};
+static void bakeBackdrop(void);
+
+// Settled cells are kept in an offscreen texture. Each frame only cells
+// that differ from what it holds are redrawn into it, then it is drawn
+// over the backdrop in strips of one texture page.
+#define CACHE_W (GRID_W * BLOCK_SIZE)
+#define CACHE_H (GRID_H * BLOCK_SIZE)
+#define CACHE_STRIP 256 // Texels a 16bpp texture page spans
+
+_Static_assert(TEX_BOARD_CACHE_X + CACHE_W <= 1024, "Board cache must fit in VRAM");
+
+static DRAWENV cacheEnv;
+static u_short cachedA[GRID_W];
+static u_short cachedB[GRID_W];
+static u_short cachedChain[GRID_W];
+static u_short cachedMarked[GRID_W];
+static int cacheRedraws = 0;
+static int cacheStale = 0; // Holds colors of an older theme
+static void resetBoardCache(void);
+
+// Retained packets: everything the board layer links each frame is built
+// once and only relinked, with changed cells patching their texture
+// coordinates. One set per buffer, the GPU may still be reading the other.
+#define CACHE_STRIPS ((CACHE_W + CACHE_STRIP - 1) / CACHE_STRIP)
+
+#if BLOCK_SIZE == 16
+typedef SPRT_16 BlockSprite;
+#else
+typedef SPRT BlockSprite;
+#endif
 
-// Internal Physics State
-static int gravityTimer = 0;
-static int doPhysicsUpdate = 0;
+typedef struct {
+  BlockSprite sprite;
+  TILE clear; // Clears the cell's texels before the sprite is drawn
+} CellPackets;
 
-// Timeline State
-static int timelineGridX = 0;
-static int timelinePixelX = 0;
-#define TIMELINE_SPEED 1
+typedef struct {
+  DR_MOVE backdrop;
+  DR_TPAGE stripPage[CACHE_STRIPS];
+  SPRT strip[CACHE_STRIPS];
+  DR_ENV toCache;
+  DR_ENV toFrame;
+  CellPackets cells[GRID_W][GRID_H];
+} BoardPackets;
+
+static BoardPackets boardPackets[2];
+static void buildBoardPackets(void);
+
+// Timeline
 #define TIMELINE_WIDTH 2
 
-// Score State
-static int score = 0;
-static int currentTimelineBlockCount = 0;
-#define BLOCK_SCORE_VALUE 1
+// Score
+#define SQUARE_SCORE_VALUE 1
+
+// Profiling
+static u_short validateTicks = 0;
+
+// Zobrist keys, one per plane, column and row. Fixed, so hashes from
+// different builds and runs can be compared.
+#define HASH_PLANES 7 // colorA, colorB, chain, then the match planes below
+#define HASH_MARKED    3
+#define HASH_PROTECTED 4
+#define HASH_LINKED    5
+#define HASH_SQUARES   6
+#define HASH_KEY_SEED 0x9E3779B9
+
+static u_int cellKeys[HASH_PLANES][GRID_W][GRID_H];
+
+// 15 bit color, zero would be transparent so black keeps the STP bit
+static u_short toClutColor(CVECTOR c, int semiTrans) {
+  u_short color = (c.r >> 3) | ((c.g >> 3) << 5) | ((c.b >> 3) << 10);
+  if (semiTrans || color == 0)
+    color |= 0x8000;
+  return color;
+}
 
-int GetScore() {
-    return score;
+static inline int blockU(int color, int look) {
+  return ((color - 1) * BLOCK_LOOKS + look) * ATLAS_CELL;
+}
+
+static inline int queueU(int color, int chain) {
+  return ATLAS_QUEUE_U + ((color - 1) * 2 + chain) * ATLAS_QUEUE_CELL;
+}
+
+static void fillTexels(int x, int y, int w, int h, int ink) {
+  for (int ty = y; ty < y + h; ty++) {
+    for (int tx = x; tx < x + w; tx++) {
+      u_short *word = &atlasTexels[ty][tx >> 2];
+      int shift = (tx & 3) * 4;
+      *word = (*word & ~(0xF << shift)) | (ink << shift);
+    }
+  }
+}
+
+// Same shapes Draw_RawBlock used to build out of tiles
+static void buildAtlas(void) {
+  int chainOffset = (BLOCK_SIZE - CHAIN_MARK_SIZE) / 2 + 1;
+  int q = QUEUE_BLOCK_SIZE;
+
+  for (int color = 1; color <= 2; color++) {
+    for (int look = 0; look < BLOCK_LOOKS; look++) {
+      int u = blockU(color, look);
+
+      switch (look % LOOK_CHAIN) {
+      case BLOCK_STYLE_NORMAL:
+        fillTexels(u + 1, 1, BLOCK_SIZE - 1, BLOCK_SIZE - 1, INK_DARK(color));
+        fillTexels(u + 2, 2, BLOCK_SIZE - 3, BLOCK_SIZE - 3, INK_LIGHT(color));
+        break;
+      case BLOCK_STYLE_MARKED:
+        fillTexels(u + 1, 1, BLOCK_SIZE - 1, BLOCK_SIZE - 1, INK_LIGHT(color));
+        break;
+      case BLOCK_STYLE_GHOST:
+        fillTexels(u + 1, 1, BLOCK_SIZE - 1, BLOCK_SIZE - 1, INK_GHOST(color));
+        break;
+      }
+
+      if (look >= LOOK_CHAIN) {
+        fillTexels(u + chainOffset, chainOffset, CHAIN_MARK_SIZE, CHAIN_MARK_SIZE, INK_WHITE);
+      }
+    }
+
+    for (int chain = 0; chain < 2; chain++) {
+      int u = queueU(color, chain);
+      fillTexels(u, 0, q - 1, q - 1, INK_LIGHT(color));
+      if (chain)
+        fillTexels(u + q / 2 - 1, q / 2 - 1, 2, 2, INK_WHITE);
+    }
+  }
+
+  RECT rect = {TEX_BLOCKS_X, TEX_BLOCKS_Y, ATLAS_W / 4, ATLAS_H};
+  LoadImage(&rect, (u_long *)atlasTexels);
+}
+
+int GetScore(const Board *board) {
+    return board->score;
 }
 
 void Grid_SetTheme(int themeIndex) {
@@ -58,25 +207,157 @@ void Grid_SetTheme(int themeIndex) {
   currentThemeIndex = themeIndex;
   const Theme *t = &THEME_LIBRARY[currentThemeIndex];
 
-  BLOCK_PALETTE_LIGHT[0] = (CVECTOR){0, 0, 0, 0};
-  BLOCK_PALETTE_DARK[0] = (CVECTOR){0, 0, 0, 0};
-  BLOCK_PALETTE_LIGHT[1] = t->block_a;
-  BLOCK_PALETTE_DARK[1] = t->block_a_dark;
-  BLOCK_PALETTE_LIGHT[2] = t->block_b;
-  BLOCK_PALETTE_DARK[2] = t->block_b_dark;
+  blockClut[INK_LIGHT(1)] = toClutColor(t->block_a, 0);
+  blockClut[INK_DARK(1)] = toClutColor(t->block_a_dark, 0);
+  blockClut[INK_GHOST(1)] = toClutColor(t->block_a_dark, 1);
+  blockClut[INK_LIGHT(2)] = toClutColor(t->block_b, 0);
+  blockClut[INK_DARK(2)] = toClutColor(t->block_b_dark, 0);
+  blockClut[INK_GHOST(2)] = toClutColor(t->block_b_dark, 1);
+  blockClut[INK_WHITE] = toClutColor((CVECTOR){255, 255, 255, 0}, 0);
+
+  RECT rect = {CLUT_BLOCKS_X, CLUT_BLOCKS_Y, 16, 1};
+  LoadImage(&rect, (u_long *)blockClut);
+
+  // The board cache stores texels already looked up in the CLUT
+  cacheStale = 1;
 }
 
-static void clearBoard(void) {
-  BlockData *ptr = (BlockData *)board;
-  for (int i = 0; i < TOTAL_CELLS; i++) {
-    ptr[i].type = 0;
-    ptr[i].marked = 0;
+static void clearBoard(Board *board) {
+  GRID_UNROLL
+  for (int x = 0; x < GRID_W; x++) {
+    board->colorA[x] = 0;
+    board->colorB[x] = 0;
+    board->marked[x] = 0;
+    board->protected[x] = 0;
+    board->squares[x] = 0;
+    board->chain[x] = 0;
+    board->linked[x] = 0;
+    board->columnTop[x] = GRID_H;
   }
+  board->squareCount = 0;
+  board->cellHash = 0; // Empty board
+
+  board->dirtyRows = 0;
+  board->dirtyMinX = GRID_W;
+  board->dirtyMaxX = -1;
+  board->unsettledColumns = 0;
+  board->gravityTimer = 0;
+
+  board->timelineGridX = 0;
+  board->timelinePhase = 0;
+  board->timelineBpm = TIMELINE_DEFAULT_BPM;
+  board->sweptColumns = 0;
+
+  board->score = 0;
+  board->timelineSquareCount = 0;
+  board->gameOver = 0;
+  board->touchedColumns = ALL_COLUMNS;
+
+  // Latches must not leak from the previous game into a replay
+  board->player = (ActivePiece){0};
+
+  Events_Clear(&board->events);
 }
 
-void Grid_Init(void) {
-  clearBoard();
+// Cell Hashing
+
+static void initCellKeys(void) {
+  u_int key = HASH_KEY_SEED;
+
+  for (int p = 0; p < HASH_PLANES; p++) {
+    for (int x = 0; x < GRID_W; x++) {
+      for (int y = 0; y < GRID_H; y++) {
+        key ^= key << 13;
+        key ^= key >> 17;
+        key ^= key << 5;
+        cellKeys[p][x][y] = key;
+      }
+    }
+  }
+}
+
+static inline u_int hashCells(const u_int *keys, u_short changed) {
+  u_int hash = 0;
+  for (int y = 0; changed; y++, changed >>= 1) {
+    if (changed & 1) hash ^= keys[y];
+  }
+  return hash;
+}
+
+// Folds a column change into the board hash, costs one XOR per changed cell
+static inline void rehashColumn(Board *board, int x, u_short oldA, u_short oldB, u_short oldChain) {
+  board->cellHash ^= hashCells(cellKeys[0][x], oldA ^ board->colorA[x]);
+  board->cellHash ^= hashCells(cellKeys[1][x], oldB ^ board->colorB[x]);
+  board->cellHash ^= hashCells(cellKeys[2][x], oldChain ^ board->chain[x]);
+}
+
+// Writes one column of a match plane, with the change folded into the hash
+static inline void setMatchPlane(Board *board, u_short *plane, int hashPlane, int x, u_short value) {
+  board->cellHash ^= hashCells(cellKeys[hashPlane][x], plane[x] ^ value);
+  plane[x] = value;
+}
+
+// Cell Access
+
+static inline int getCellType(const Board *board, int x, int y) {
+  int chain = (board->chain[x] & (1 << y)) ? CELL_CHAIN : 0;
+  if (board->colorA[x] & (1 << y)) return 1 | chain;
+  if (board->colorB[x] & (1 << y)) return 2 | chain;
+  return 0;
+}
+
+static inline void setCellType(Board *board, int x, int y, int type) {
+  u_short bit = 1 << y;
+  u_short oldA = board->colorA[x];
+  u_short oldB = board->colorB[x];
+  u_short oldChain = board->chain[x];
+
+  board->colorA[x] &= ~bit;
+  board->colorB[x] &= ~bit;
+  board->chain[x] &= ~bit;
+  if ((type & CELL_COLOR_MASK) == 1) board->colorA[x] |= bit;
+  if ((type & CELL_COLOR_MASK) == 2) board->colorB[x] |= bit;
+  if (type & CELL_CHAIN) board->chain[x] |= bit;
+
+  rehashColumn(board, x, oldA, oldB, oldChain);
+}
+
+// Keeps the height map in sync, call after a column's blocks changed
+static inline void refreshColumnTop(Board *board, int x) {
+  u_short occupied = board->colorA[x] | board->colorB[x];
+  int y = 0;
+
+  if (!occupied) {
+    board->columnTop[x] = GRID_H;
+    return;
+  }
+
+  while (!(occupied & 1)) {
+    occupied >>= 1;
+    y++;
+  }
+  board->columnTop[x] = y;
+}
+
+static inline void markDirty(Board *board, int x, u_short rows) {
+  board->touchedColumns |= 1 << x;
+  board->dirtyRows |= rows;
+  if (x < board->dirtyMinX) board->dirtyMinX = x;
+  if (x > board->dirtyMaxX) board->dirtyMaxX = x;
+}
+
+static inline int countBits(u_short mask) {
+  int count = 0;
+  while (mask) {
+    mask &= mask - 1;
+    count++;
+  }
+  return count;
+}
+
+void Grid_InitGraphics(void) {
   Grid_SetTheme(10);
+  buildAtlas();
 
   // Texture Loading
   LoadTexture((u_long *)bg_left_tim, &bgLeftInfo, TEX_BG_LEFT_X, TEX_BG_LEFT_Y);
@@ -84,135 +365,271 @@ void Grid_Init(void) {
   bgLeftInfo.mode = getTPage(2, 0, TEX_BG_LEFT_X, TEX_BG_LEFT_Y);
   bgRightInfo.mode = getTPage(2, 0, TEX_BG_RIGHT_X, TEX_BG_RIGHT_Y);
 
-  score = 0;
+  bakeBackdrop();
+  System_SetClear(0); // The backdrop covers the whole frame
+  resetBoardCache();
+  buildBoardPackets();
+}
+
+void Grid_Init(Board *board, u_int seed) {
+  initCellKeys();
+  clearBoard(board);
+
+  Player_Seed(board, seed);
+  Player_Init(board);
+
+  // Every skin sweeps at its own tempo
+  Grid_SetTempo(board, THEME_LIBRARY[currentThemeIndex].bpm);
+}
+
+// Takes effect from the next tick, the position within the column is kept
+void Grid_SetTempo(Board *board, int bpm) {
+  if (bpm < 1)
+    bpm = 1;
+  board->timelineBpm = bpm;
+}
 
-  Player_Init();
+// Boards hold no pointers, a plain struct copy is a complete snapshot
+void Grid_Clone(Board *dst, const Board *src) {
+  *dst = *src;
 }
 
 // Timeline Logic
 
-static void checkSweptColumn(int col) {
-    int blocksCleared = 0;
+// Hands every column erased by the group to the gravity engine at once
+static void releaseSweptColumns(Board *board) {
+    if (!board->sweptColumns) return;
 
-    for (int y = 0; y < GRID_H; y++) {
-        if (board[y][col].marked) {
-            // Destroy Block
-            board[y][col].type = 0;
-            board[y][col].marked = 0;
-
-            // Protect Right Neighbor
-            // Neighbor will wait for timeline to be updated
-            if (col < GRID_W - 1) {
-                board[y][col + 1].protected = 1;
-            }
-
-            currentTimelineBlockCount += 1;
-            blocksCleared = 1;
+    board->unsettledColumns |= board->sweptColumns;
+    board->sweptColumns = 0;
+    board->gravityTimer = 0;
+}
+
+// Erases a whole column with one mask per plane.
+// A group of marked columns is held in place until the timeline leaves it.
+static void checkSweptColumn(Board *board, int col) {
+    u_short cleared = board->marked[col];
+
+    if (cleared) {
+        // Destroy Blocks
+        board->cellHash ^= hashCells(cellKeys[0][col], board->colorA[col] & cleared);
+        board->cellHash ^= hashCells(cellKeys[1][col], board->colorB[col] & cleared);
+        board->cellHash ^= hashCells(cellKeys[2][col], board->chain[col] & cleared);
+        board->colorA[col] &= ~cleared;
+        board->colorB[col] &= ~cleared;
+        board->chain[col] &= ~cleared;
+        setMatchPlane(board, board->linked, HASH_LINKED, col, 0);
+        setMatchPlane(board, board->marked, HASH_MARKED, col, 0);
+        refreshColumnTop(board, col);
+        markDirty(board, col, cleared);
+
+        // Protect Right Neighbors
+        // Neighbors will wait for timeline to be updated
+        if (col < GRID_W - 1) {
+            setMatchPlane(board, board->protected, HASH_PROTECTED, col + 1, board->protected[col + 1] | cleared);
         }
 
-        // Always remove protection from the block
-        board[y][col].protected = 0;
-    }
+        // Every square touching the column was fully marked, so it goes with it
+        int squares = countBits(board->squares[col]);
+        setMatchPlane(board, board->squares, HASH_SQUARES, col, 0);
+        if (col > 0) {
+            squares += countBits(board->squares[col - 1]);
+            setMatchPlane(board, board->squares, HASH_SQUARES, col - 1, 0);
+        }
+        board->squareCount -= squares;
+        board->timelineSquareCount += squares;
+        board->sweptColumns |= 1 << col;
 
-    if (blocksCleared) {
-        doPhysicsUpdate = 1;
-        gravityTimer = 0;
+        Events_Push(&board->events, EVENT_COLUMN_SWEPT, col, countBits(cleared));
+    } else {
+        releaseSweptColumns(board);
     }
+
+    // Always remove protection from the column
+    setMatchPlane(board, board->protected, HASH_PROTECTED, col, 0);
+    board->touchedColumns |= ((ColumnSet)7 << col >> 1) & ALL_COLUMNS; // Neighbors' squares and protection
 }
 
-static void UpdateTimeline(void) {
-  timelinePixelX += TIMELINE_SPEED;
+static void UpdateTimeline(Board *board) {
+  board->timelinePhase += board->timelineBpm * TIMELINE_COLUMNS_PER_BEAT;
 
-  if (timelinePixelX >= BLOCK_SIZE) {
-    timelinePixelX = 0;
+  // Fast tempos may cross more than one column per tick
+  while (board->timelinePhase >= TIMELINE_COLUMN_UNITS) {
+    board->timelinePhase -= TIMELINE_COLUMN_UNITS;
 
-    checkSweptColumn(timelineGridX);
+    checkSweptColumn(board, board->timelineGridX);
 
-    timelineGridX++;
+    board->timelineGridX++;
 
-    if (timelineGridX >= GRID_W) {
-      timelineGridX = 0;
+    if (board->timelineGridX >= GRID_W) {
+      board->timelineGridX = 0;
 
-      // Divide blocks by 4 to get the amount of squares
-      score += (currentTimelineBlockCount >> 2) * BLOCK_SCORE_VALUE;
+      // The right edge ends any group still being swept
+      releaseSweptColumns(board);
 
-      currentTimelineBlockCount = 0;
+      board->score += board->timelineSquareCount * SQUARE_SCORE_VALUE;
+      Events_Push(&board->events, EVENT_PASS_COMPLETE, 0, board->timelineSquareCount);
+
+      board->timelineSquareCount = 0;
     }
   }
 }
 
 // Block Match Logic
+
+// Bit y set means a 2x2 square with its top-left cell at (gridX, y).
 // Does NOT check bounds, caller beware.
-static inline void checkSquareAt(int gridX, int gridY) {
-    int type = board[gridY][gridX].type;
+static inline u_short squaresAt(const Board *board, int gridX) {
+    u_short a = board->colorA[gridX] & board->colorA[gridX + 1];
+    u_short b = board->colorB[gridX] & board->colorB[gridX + 1];
+    return (a & (a >> 1)) | (b & (b >> 1));
+}
 
-    if (type == 0) return; // No block here
+// Recomputes a column pair's squares and keeps board->squareCount in sync.
+// Bits are only counted when the pair actually changed, squares that did
+// not exist before are added to formed.
+static inline u_short updateSquaresAt(Board *board, int gridX, int *formed) {
+    u_short squares = squaresAt(board, gridX);
 
-    // Check Neighbors
-    if (board[gridY][gridX + 1].type == type && board[gridY + 1][gridX].type == type && board[gridY + 1][gridX + 1].type == type) {
-        board[gridY][gridX].marked = 1;
-        board[gridY][gridX + 1].marked = 1;
-        board[gridY + 1][gridX].marked = 1;
-        board[gridY + 1][gridX + 1].marked = 1;
+    if (squares != board->squares[gridX]) {
+        board->squareCount += countBits(squares) - countBits(board->squares[gridX]);
+        *formed += countBits(squares & ~board->squares[gridX]);
+        setMatchPlane(board, board->squares, HASH_SQUARES, gridX, squares);
     }
+    return squares;
 }
 
+// Chain Blocks
+
+// Grows region (a subset of cells) to every cell of cells it touches
+// vertically. Kogge-Stone fill: four shift steps cover 16 rows, in each
+// direction, no matter how many runs or seeds the column holds.
+static inline u_short fillColumn(u_short region, u_short cells) {
+    u_short up = region, down = region;
+    u_short passUp = cells, passDown = cells;
+
+    up |= passUp & (up << 1);
+    down |= passDown & (down >> 1);
+    passUp &= passUp << 1;
+    passDown &= passDown >> 1;
+    up |= passUp & (up << 2);
+    down |= passDown & (down >> 2);
+    passUp &= passUp << 2;
+    passDown &= passDown >> 2;
+    up |= passUp & (up << 4);
+    down |= passDown & (down >> 4);
+    passUp &= passUp << 4;
+    passDown &= passDown >> 4;
+    up |= passUp & (up << 8);
+    down |= passDown & (down >> 8);
+
+    return up | down;
+}
 
-void Grid_ScanNeighborhood(int targetX, int targetY) {
-    // Off grid
-    if (targetX < 0 || targetX >= GRID_W || targetY < 0 || targetY >= GRID_H) return;
+// Connected region of one color plane reachable from region, in place.
+// A left-to-right then right-to-left sweep carries the region along any
+// horizontal run in either direction and fillColumn crosses vertical runs
+// in one step, so a round only fails to finish when the region doubles
+// back on itself. Every round but the last adds cells, which bounds the
+// loop by the cell count; winding worst cases on a 16x10 board take about
+// ten rounds of 2 * GRID_W column steps, a few dozen ALU ops each.
+static void fillRegion(u_short *region, const u_short *cells) {
+    int changed;
+
+    do {
+        changed = 0;
+        u_short carry = 0;
+        GRID_UNROLL
+        for (int x = 0; x < GRID_W; x++) {
+            u_short r = fillColumn((region[x] | carry) & cells[x], cells[x]);
+            if (r != region[x]) { region[x] = r; changed = 1; }
+            carry = r;
+        }
+        carry = 0;
+        GRID_UNROLL
+        for (int x = GRID_W - 1; x >= 0; x--) {
+            u_short r = fillColumn((region[x] | carry) & cells[x], cells[x]);
+            if (r != region[x]) { region[x] = r; changed = 1; }
+            carry = r;
+        }
+    } while (changed);
+}
 
-    // Check Bottom Right Square
-    if (targetX < GRID_W - 1 && targetY < GRID_H - 1) {
-        checkSquareAt(targetX, targetY);
-    }
+// A chain block that is part of a square links every block of its color
+// connected to it. Linked cells stay marked until the timeline sweeps them.
+static void linkChains(Board *board) {
+    u_short regionA[GRID_W];
+    u_short regionB[GRID_W];
+    u_short seeds = 0;
 
-    // Check Bottom Left Square
-    if (targetX > 0 && targetY < GRID_H - 1) {
-        checkSquareAt(targetX - 1, targetY);
+    GRID_UNROLL
+    for (int x = 0; x < GRID_W; x++) {
+        u_short s = board->chain[x] & board->marked[x];
+        regionA[x] = s & board->colorA[x];
+        regionB[x] = s & board->colorB[x];
+        seeds |= s;
     }
+    if (!seeds) return;
 
-    // Check Top Right Square
-    if (targetX < GRID_W - 1 && targetY > 0) {
-        checkSquareAt(targetX, targetY - 1);
-    }
+    fillRegion(regionA, board->colorA);
+    fillRegion(regionB, board->colorB);
 
-    // Check Top Left Square
-    if (targetX > 0 && targetY > 0) {
-        checkSquareAt(targetX - 1, targetY - 1);
+    // Only columns that gained cells count as touched, a standing chain
+    // region must not make every tick a full board change
+    GRID_UNROLL
+    for (int x = 0; x < GRID_W; x++) {
+        u_short linked = board->linked[x] | regionA[x] | regionB[x];
+        u_short marked = board->marked[x] | linked;
+        if (linked != board->linked[x] || marked != board->marked[x]) {
+            board->touchedColumns |= (ColumnSet)1 << x;
+        }
+        setMatchPlane(board, board->linked, HASH_LINKED, x, linked);
+        setMatchPlane(board, board->marked, HASH_MARKED, x, marked);
     }
-
 }
 
-void Grid_ValidateMatches(void) {
-    // Unmark all
-    for (int y = 0; y < GRID_H; y++) {
-        for (int x = 0; x < GRID_W; x++) {
-            if(board[y][x].protected) continue;
-
-            board[y][x].marked = 0;
-        }
+// Re-evaluates squares over the dirty region plus a one-cell border.
+// Marks outside of it cannot have changed since the last call, so the
+// result is identical to unmarking and rescanning the whole board.
+void Grid_ValidateMatches(Board *board) {
+    if (board->dirtyMaxX < 0) return; // Nothing changed
+
+    u_short start = Perf_Now();
+    u_short rows = (board->dirtyRows | (board->dirtyRows << 1) | (board->dirtyRows >> 1)) & COLUMN_MASK;
+    int minX = (board->dirtyMinX > 0) ? board->dirtyMinX - 1 : 0;
+    int maxX = (board->dirtyMaxX < GRID_W - 1) ? board->dirtyMaxX + 1 : GRID_W - 1;
+
+    // Squares are rewritten from minX - 1, marks from minX, both up to maxX
+    int lowX = (minX > 0) ? minX - 1 : 0;
+    board->touchedColumns |= (ALL_COLUMNS >> (GRID_W - 1 - maxX)) & ~(((ColumnSet)1 << lowX) - 1);
+
+    int formed = 0;
+    u_short left = (minX > 0) ? updateSquaresAt(board, minX - 1, &formed) : 0;
+    GRID_UNROLL
+    for (int x = minX; x <= maxX; x++) {
+        u_short right = (x < GRID_W - 1) ? updateSquaresAt(board, x, &formed) : 0;
+        u_short cells = left | right;
+        cells |= cells << 1;
+
+        // Unmark unprotected cells, then mark the squares again
+        u_short keep = board->protected[x] | board->linked[x] | ~rows;
+        setMatchPlane(board, board->marked, HASH_MARKED, x, (board->marked[x] & keep) | (cells & rows));
+        left = right;
     }
 
-    for (int y = 0; y < GRID_H - 1; y++) {
-        for (int x = 0; x < GRID_W - 1; x++) {
-        int type = board[y][x].type;
+    linkChains(board);
 
-        if (type == 0)
-            continue;
+    if (formed) Events_Push(&board->events, EVENT_SQUARES_FORMED, minX, formed);
 
-        if (board[y][x + 1].type == type && board[y + 1][x].type == type && board[y + 1][x + 1].type == type) {
-            board[y][x].marked = 1;
-            board[y][x + 1].marked = 1;
-            board[y + 1][x].marked = 1;
-            board[y + 1][x + 1].marked = 1;
-        }
-        }
-    }
+    board->dirtyRows = 0;
+    board->dirtyMinX = GRID_W;
+    board->dirtyMaxX = -1;
+
+    validateTicks = Perf_Since(start);
 }
 
 // Collision Logic
-int Grid_IsMoveValid(int nextX, int nextY) {
+int Grid_IsMoveValid(const Board *board, int nextX, int nextY) {
   // Bounds Check
   if (nextX < 0)
     return 0;
@@ -225,29 +642,66 @@ int Grid_IsMoveValid(int nextX, int nextY) {
   if (nextY < -1)
     return 1;
 
-  // "Portal" entry check (entering top of grid)
-  if (nextY == -1) {
-    if (board[0][nextX].type != 0)
-      return 0;
-    if (board[0][nextX + 1].type != 0)
-      return 0;
-    return 1;
-  }
+  // Rows nextY and nextY + 1; only row 0 when at the "portal" (entering top of grid)
+  u_short rows = (3 << (nextY + 1)) >> 1;
+  u_short occupied = board->colorA[nextX] | board->colorB[nextX] | board->colorA[nextX + 1] | board->colorB[nextX + 1];
 
-  // Standard Grid Collision
-  if (board[nextY + 1][nextX].type != 0)
-    return 0; // Bottom Left
-  if (board[nextY + 1][nextX + 1].type != 0)
-    return 0; // Bottom Right
-  if (board[nextY][nextX].type != 0)
-    return 0; // Top Left
-  if (board[nextY][nextX + 1].type != 0)
-    return 0; // Top Right
+  return (occupied & rows) == 0;
+}
+
+// Fingerprint of everything that decides the game's future: cells, match
+// and gravity state, piece, generator, timeline and score. Every cell and
+// match plane is kept incrementally, the rest is folded in FNV-1a style.
+#define CHECKSUM_PRIME 0x01000193
+
+static inline u_int mixWord(u_int hash, u_int value) {
+  return (hash ^ value) * CHECKSUM_PRIME;
+}
 
-  return 1;
+u_int Grid_Checksum(const Board *board) {
+  const ActivePiece *p = &board->player;
+  u_int hash = board->cellHash;
+
+  hash = mixWord(hash, p->gridX);
+  hash = mixWord(hash, p->gridY);
+  hash = mixWord(hash, p->cells[0] | (p->cells[1] << 8) | (p->cells[2] << 16) | (p->cells[3] << 24));
+  hash = mixWord(hash, p->active | (p->dropLock << 1) | (p->slamLatch << 2));
+  hash = mixWord(hash, p->dropTimer | (p->graceCycles << 16));
+  hash = mixWord(hash, board->rngState);
+  hash = mixWord(hash, board->timelineGridX);
+  hash = mixWord(hash, board->timelinePhase);
+  hash = mixWord(hash, board->score);
+
+  // Outputs of the incremental kernels, so a divergence shows on its own
+  // tick. Their planes are already in cellHash.
+  hash = mixWord(hash, board->squareCount);
+  hash = mixWord(hash, board->unsettledColumns);
+  hash = mixWord(hash, board->sweptColumns);
+  hash = mixWord(hash, board->gravityTimer);
+  return hash;
+}
+
+// Lowest gridY a piece at (x, y) can fall to.
+// Constant time unless the piece has slid under an overhang.
+int Grid_GetLandingY(const Board *board, int x, int y) {
+  if (x < 0 || x > GRID_W - 2)
+    return y;
+
+  int top = board->columnTop[x];
+  if (board->columnTop[x + 1] < top)
+    top = board->columnTop[x + 1];
+
+  // Piece is above everything in its columns, rest on the highest block
+  if (y + 1 < top)
+    return top - 2;
+
+  while (Grid_IsMoveValid(board, x, y + 1)) {
+    y++;
+  }
+  return y;
 }
 
-void Grid_PlaceBlock(ActivePiece *p) {
+void Grid_PlaceBlock(Board *board, const ActivePiece *p) {
   int x = p->gridX;
   int y = p->gridY;
 
@@ -257,69 +711,107 @@ void Grid_PlaceBlock(ActivePiece *p) {
 
   // Place Top Half
   if (y >= 0) {
-      board[y][x].type = p->cells[0];
-      board[y][x + 1].type = p->cells[1];
-      Grid_ScanNeighborhood(x, y);
-      Grid_ScanNeighborhood(x + 1, y);
+      setCellType(board, x, y, p->cells[0]);
+      setCellType(board, x + 1, y, p->cells[1]);
+      markDirty(board, x, 1 << y);
+      markDirty(board, x + 1, 1 << y);
   }
 
   // Place Bottom Half if Inside Grid
   if (y + 1 >= 0) {
-      board[y + 1][x].type = p->cells[2];
-      board[y + 1][x + 1].type = p->cells[3];
-      Grid_ScanNeighborhood(x, y + 1);
-      Grid_ScanNeighborhood(x + 1, y + 1);
+      setCellType(board, x, y + 1, p->cells[2]);
+      setCellType(board, x + 1, y + 1, p->cells[3]);
+      markDirty(board, x, 1 << (y + 1));
+      markDirty(board, x + 1, 1 << (y + 1));
   }
 
-  // Reset Player
-  p->active = 0;
-  doPhysicsUpdate = 1;
-  gravityTimer = 0;
+  refreshColumnTop(board, x);
+  refreshColumnTop(board, x + 1);
+  Events_Push(&board->events, EVENT_PIECE_LANDED, x, y);
+  Grid_ValidateMatches(board);
+
+  board->unsettledColumns |= 3 << x;
+  board->gravityTimer = 0;
 }
 
 // Physics: Gravity for settled blocks
-static void Grid_UpdatePhysics(void) {
-  doPhysicsUpdate = 0;
-  int stabilityChanged = 0;
-  for (int y = GRID_H - 2; y >= 0; y--) {
-    for (int x = 0; x < GRID_W; x++) {
-      // If block exists and space below is empty
-      if (board[y][x].type != 0 && board[y + 1][x].type == 0) {
-        board[y + 1][x].type = board[y][x].type;
-        board[y + 1][x].marked = 0;
-        board[y + 1][x].protected = 0;
 
-        board[y][x].type = 0;
-        board[y][x].marked = 0;
-        board[y][x].protected = 0;
+// Blocks with an empty cell anywhere below them in the column.
+static inline u_short fallingCells(const Board *board, int x) {
+  u_short occupied = board->colorA[x] | board->colorB[x];
+  u_short holes = ~occupied & COLUMN_MASK;
 
-        Grid_ScanNeighborhood(x, y + 1); // Scan new position for matches
+  // Smear the lowest hole upwards, everything above it falls
+  holes |= holes >> 1;
+  holes |= holes >> 2;
+  holes |= holes >> 4;
+  holes |= holes >> 8;
 
-        // If the block moved, check if it can move again next frame
-        if (y + 2 < GRID_H && board[y + 2][x].type == 0) {
-          doPhysicsUpdate = 1;
-        }
-        stabilityChanged = 1;
-      }
+  return occupied & (holes >> 1);
+}
+
+// Moves every falling segment of each unsettled column down one cell.
+// Settled columns are skipped entirely.
+static void Grid_UpdatePhysics(Board *board) {
+  ColumnSet columns = board->unsettledColumns;
+  int stabilityChanged = 0;
+
+  // Walks only up to the last unsettled column, left rolled on purpose
+  for (int x = 0; columns; x++, columns >>= 1) {
+    if (!(columns & 1)) continue;
+
+    u_short falling = fallingCells(board, x);
+    u_short moved = falling | (falling << 1);
+
+    if (falling) {
+      u_short oldA = board->colorA[x];
+      u_short oldB = board->colorB[x];
+      u_short oldChain = board->chain[x];
+
+      board->colorA[x] = (board->colorA[x] & ~falling) | ((board->colorA[x] & falling) << 1);
+      board->colorB[x] = (board->colorB[x] & ~falling) | ((board->colorB[x] & falling) << 1);
+      board->chain[x] = (board->chain[x] & ~falling) | ((board->chain[x] & falling) << 1);
+      rehashColumn(board, x, oldA, oldB, oldChain);
+      setMatchPlane(board, board->marked, HASH_MARKED, x, board->marked[x] & ~moved);
+      setMatchPlane(board, board->linked, HASH_LINKED, x, board->linked[x] & ~moved);
+      setMatchPlane(board, board->protected, HASH_PROTECTED, x, board->protected[x] & ~moved);
+      refreshColumnTop(board, x);
+      markDirty(board, x, moved);
+      stabilityChanged = 1;
     }
+
+    // Column stays unsettled until nothing is left to fall
+    if (!falling || !fallingCells(board, x)) {
+      board->unsettledColumns &= ~(1 << x);
+    }
+  }
+
+  if (stabilityChanged) Grid_ValidateMatches(board);
+}
+
+// Lets every falling block come to rest at once, for boards that are
+// being looked ahead on rather than played
+void Grid_Settle(Board *board) {
+  while (board->unsettledColumns) {
+    Grid_UpdatePhysics(board);
   }
-  if (stabilityChanged) Grid_ValidateMatches();
+  board->gravityTimer = 0;
 }
 
-void Grid_Update(void) {
+void Grid_Update(Board *board) {
   // Update Player Logic
-  Player_Update();
+  Player_Update(board);
 
-  UpdateTimeline();
+  UpdateTimeline(board);
 
   // Update World Physics
-  if (doPhysicsUpdate) {
-    gravityTimer++;
+  if (board->unsettledColumns) {
+    board->gravityTimer++;
   }
 
-  if (gravityTimer >= GRAVITY_DELAY_FRAMES) {
-    gravityTimer = 0;
-    Grid_UpdatePhysics();
+  if (board->gravityTimer >= GRAVITY_DELAY_TICKS) {
+    board->gravityTimer = 0;
+    Grid_UpdatePhysics(board);
   }
 }
 
@@ -327,49 +819,98 @@ void Grid_Update(void) {
 // Rendering Helpers (Kept internal to Grid for now)
 // ---------------------------------------------------------
 
-static void Draw_RawBlock(int x, int y, int type, int marked, int z_index) {
+// One atlas cell, with the fixed size sprite packets where they fit
+static inline void drawAtlasCell(int x, int y, int u, int size, int semiTrans, int z_index) {
+  if (size == 16)
+    Draw_Sprite16(x, y, u, 0, BLOCK_CLUT, semiTrans, z_index);
+  else if (size == 8)
+    Draw_Sprite8(x, y, u, 0, BLOCK_CLUT, semiTrans, z_index);
+  else
+    Draw_SpriteWH(x, y, u, 0, size, size, BLOCK_CLUT, semiTrans, z_index);
+}
+
+// Atlas position of a cell type drawn in a block style
+static inline int cellU(int type, int style) {
+  int look = style;
+  if ((type & CELL_CHAIN) && style != BLOCK_STYLE_GHOST)
+    look += LOOK_CHAIN;
+  return blockU(type & CELL_COLOR_MASK, look);
+}
+
+static void Draw_RawBlock(int x, int y, int type, int style, int z_index) {
   if (type <= 0)
     return;
-  CVECTOR *cLight = &BLOCK_PALETTE_LIGHT[type];
-  CVECTOR *cDark = &BLOCK_PALETTE_DARK[type];
-
-  if (marked) {
-    Draw_Rect(x + 1, y + 1, BLOCK_SIZE - 1, BLOCK_SIZE - 1, cLight->r,
-              cLight->g, cLight->b, z_index);
-  } else {
-    Draw_Rect(x + 2, y + 2, BLOCK_SIZE - 3, BLOCK_SIZE - 3, cLight->r,
-              cLight->g, cLight->b, z_index);
-    Draw_Rect(x + 1, y + 1, BLOCK_SIZE - 1, BLOCK_SIZE - 1, cDark->r, cDark->g,
-              cDark->b, z_index);
-  }
+
+  drawAtlasCell(x, y, cellU(type, style), BLOCK_SIZE, style == BLOCK_STYLE_GHOST, z_index);
+}
+
+static void drawPiece(const ActivePiece *p, int baseX, int baseY, int style,
+                      int z_index) {
+  Draw_RawBlock(baseX, baseY, p->cells[0], style, z_index);
+  Draw_RawBlock(baseX + BLOCK_SIZE, baseY, p->cells[1], style, z_index);
+  Draw_RawBlock(baseX, baseY + BLOCK_SIZE, p->cells[2], style, z_index);
+  Draw_RawBlock(baseX + BLOCK_SIZE, baseY + BLOCK_SIZE, p->cells[3], style,
+                z_index);
 }
 
-static void drawActiveBlock(int z_index) {
-  if (!player.active)
+static void drawActiveBlock(const Board *board, int z_index) {
+  const ActivePiece *p = &board->player;
+
+  if (!p->active)
     return;
 
   int gridExtentX = (BLOCK_SIZE * GRID_W) >> 1;
   int gridExtentY = (BLOCK_SIZE * GRID_H) >> 1;
-  int originX = gridOffsetX - gridExtentX;
-  int originY = gridOffsetY - gridExtentY;
+  int originX = GRID_OFFSET_X - gridExtentX;
+  int originY = GRID_OFFSET_Y - gridExtentY;
 
-  int baseX = originX + (player.gridX * BLOCK_SIZE);
-  int baseY = originY + (player.gridY * BLOCK_SIZE);
+  int baseX = originX + (p->gridX * BLOCK_SIZE);
+  int baseY = originY + (p->gridY * BLOCK_SIZE);
 
-  Draw_RawBlock(baseX, baseY, player.cells[0], 0, z_index);
-  Draw_RawBlock(baseX + BLOCK_SIZE, baseY, player.cells[1], 0, z_index);
-  Draw_RawBlock(baseX, baseY + BLOCK_SIZE, player.cells[2], 0, z_index);
-  Draw_RawBlock(baseX + BLOCK_SIZE, baseY + BLOCK_SIZE, player.cells[3], 0,
-                z_index);
+  drawPiece(p, baseX, baseY, BLOCK_STYLE_NORMAL, z_index);
+
+  // Landing preview
+  int landingY = Grid_GetLandingY(board, p->gridX, p->gridY);
+  if (landingY > p->gridY) {
+    drawPiece(p, baseX, originY + (landingY * BLOCK_SIZE), BLOCK_STYLE_GHOST,
+              z_index);
+  }
 }
 
-static void drawTimeline(int z_index) {
+#define QUEUE_SPACING (QUEUE_BLOCK_SIZE * 5 / 2)
+
+// Next pieces at half size, stacked down the left margin
+static void drawQueue(const Board *board, int z_index) {
   int gridExtentX = (BLOCK_SIZE * GRID_W) >> 1;
   int gridExtentY = (BLOCK_SIZE * GRID_H) >> 1;
-  int originX = gridOffsetX - gridExtentX;
-  int originY = gridOffsetY - gridExtentY;
+  int originX = GRID_OFFSET_X - gridExtentX;
+  int originY = GRID_OFFSET_Y - gridExtentY;
+
+  int baseX = (originX - 2 * QUEUE_BLOCK_SIZE) >> 1;
+
+  for (int i = 0; i < PIECE_QUEUE_LENGTH; i++) {
+    const int *cells = board->pieceQueue[(board->pieceQueueHead + i) % PIECE_QUEUE_LENGTH];
+    int baseY = originY + i * QUEUE_SPACING;
 
-  int lineX = originX + (timelineGridX * BLOCK_SIZE) + timelinePixelX;
+    for (int c = 0; c < 4; c++) {
+      int x = baseX + (c & 1) * QUEUE_BLOCK_SIZE;
+      int y = baseY + (c >> 1) * QUEUE_BLOCK_SIZE;
+      int u = queueU(cells[c] & CELL_COLOR_MASK, (cells[c] & CELL_CHAIN) != 0);
+
+      drawAtlasCell(x, y, u, QUEUE_BLOCK_SIZE, 0, z_index);
+    }
+  }
+}
+
+static void drawTimeline(const Board *board, int z_index) {
+  int gridExtentX = (BLOCK_SIZE * GRID_W) >> 1;
+  int gridExtentY = (BLOCK_SIZE * GRID_H) >> 1;
+  int originX = GRID_OFFSET_X - gridExtentX;
+  int originY = GRID_OFFSET_Y - gridExtentY;
+
+  // Floor of the exact position, so the line never steps backwards
+  int position = board->timelineGridX * TIMELINE_COLUMN_UNITS + board->timelinePhase;
+  int lineX = originX + (position * BLOCK_SIZE) / TIMELINE_COLUMN_UNITS;
 
   Draw_Rect(lineX, originY - BLOCK_SIZE, TIMELINE_WIDTH,
             (BLOCK_SIZE * GRID_H) + BLOCK_SIZE, 255, 127, 80, z_index);
@@ -380,12 +921,12 @@ static void drawGridLines(int z_lines, int z_bg) {
   int gridExtentY = (BLOCK_SIZE * GRID_H) >> 1;
 
   // Background Rect
-  Draw_Rect_SemiTrans(gridOffsetX - gridExtentX, gridOffsetY - gridExtentY,
+  Draw_Rect_SemiTrans(GRID_OFFSET_X - gridExtentX, GRID_OFFSET_Y - gridExtentY,
                       gridExtentX << 1, gridExtentY << 1, COLOR_GRID_BG, z_bg);
 
-  int currentX = gridOffsetX + gridExtentX;
-  int topY = gridOffsetY - gridExtentY;
-  int botY = gridOffsetY + gridExtentY;
+  int currentX = GRID_OFFSET_X + gridExtentX;
+  int topY = GRID_OFFSET_Y - gridExtentY;
+  int botY = GRID_OFFSET_Y + gridExtentY;
 
   // Vertical
   for (int i = 0; i <= GRID_W; i++) {
@@ -396,9 +937,9 @@ static void drawGridLines(int z_lines, int z_bg) {
   }
 
   // Horizontal
-  int currentY = gridOffsetY + gridExtentY;
-  int leftX = gridOffsetX - gridExtentX;
-  int rightX = gridOffsetX + gridExtentX;
+  int currentY = GRID_OFFSET_Y + gridExtentY;
+  int leftX = GRID_OFFSET_X - gridExtentX;
+  int rightX = GRID_OFFSET_X + gridExtentX;
   for (int i = 1; i <= GRID_H; i++) {
     if (currentY >= 0 && currentY <= SCREENYRES) {
       Draw_Line(leftX, currentY, rightX, currentY, COLOR_GRID_LINES, z_lines);
@@ -407,35 +948,205 @@ static void drawGridLines(int z_lines, int z_bg) {
   }
 }
 
-void Grid_Draw(void) {
-  // 1. Draw Background Sprites
+// Renders the static layers into the backdrop area with the frame's own
+// OT and packet buffer, then hands both back empty
+static void bakeBackdrop(void) {
+  DrawSync(0);
+
+  DRAWENV env;
+  SetDefDrawEnv(&env, TEX_BACKDROP_X, TEX_BACKDROP_Y, SCREENXRES, SCREENYRES);
+  PutDrawEnv(&env);
+
+  char *start = nextpri;
+  System_ClearOT();
+
   Draw_Sprite(0, 0, 0, 0, 160, 240, bgLeftInfo.mode, 7);
   Draw_Sprite(160, 0, 0, 0, 160, 240, bgRightInfo.mode, 7);
+  drawGridLines(3, 5);
 
-  // 2. Draw Static Grid
-  int gridExtentX = (BLOCK_SIZE * GRID_W) >> 1;
-  int gridExtentY = (BLOCK_SIZE * GRID_H) >> 1;
-  int originX = gridOffsetX - gridExtentX;
-  int originY = gridOffsetY - gridExtentY;
+  DrawOTag(&ot[db][OTLEN - 1]);
+  DrawSync(0);
+
+  nextpri = start;
+  System_ClearOT();
+}
+
+static void resetBoardCache(void) {
+  RECT rect = {TEX_BOARD_CACHE_X, TEX_BOARD_CACHE_Y, CACHE_W, CACHE_H};
+  ClearImage(&rect, 0, 0, 0);
+
+  SetDefDrawEnv(&cacheEnv, TEX_BOARD_CACHE_X, TEX_BOARD_CACHE_Y, CACHE_W, CACHE_H);
+  cacheEnv.tpage = BLOCK_TPAGE;
+
+  for (int x = 0; x < GRID_W; x++) {
+    cachedA[x] = 0;
+    cachedB[x] = 0;
+    cachedChain[x] = 0;
+    cachedMarked[x] = 0;
+  }
+  cacheStale = 0;
+}
+
+static void buildBoardPackets(void) {
+  int originX = GRID_OFFSET_X - (CACHE_W >> 1);
+  int originY = GRID_OFFSET_Y - (CACHE_H >> 1);
+
+  for (int b = 0; b < 2; b++) {
+    BoardPackets *packets = &boardPackets[b];
+
+    SetDrawMove(&packets->backdrop, &backdropRect, draw[b].ofs[0], draw[b].ofs[1]);
+    SetDrawEnv(&packets->toCache, &cacheEnv);
+    SetDrawEnv(&packets->toFrame, &draw[b]);
+
+    for (int i = 0; i < CACHE_STRIPS; i++) {
+      int u = i * CACHE_STRIP;
+      SPRT *strip = &packets->strip[i];
+
+      SetDrawTPage(&packets->stripPage[i], 0, 1, getTPage(2, 0, TEX_BOARD_CACHE_X + u, TEX_BOARD_CACHE_Y));
+      setSprt(strip);
+      setXY0(strip, originX + u, originY);
+      setUV0(strip, 0, 0);
+      setWH(strip, (CACHE_W - u < CACHE_STRIP) ? CACHE_W - u : CACHE_STRIP, CACHE_H);
+      setRGB0(strip, 128, 128, 128);
+      strip->clut = 0;
+    }
 
-  for (int y = 0; y < GRID_H; y++) {
     for (int x = 0; x < GRID_W; x++) {
-      if (board[y][x].type != 0) {
-        int px = originX + (x * BLOCK_SIZE);
-        int py = originY + (y * BLOCK_SIZE);
-        Draw_RawBlock(px, py, board[y][x].type, board[y][x].marked, 4);
+      for (int y = 0; y < GRID_H; y++) {
+        CellPackets *cell = &packets->cells[x][y];
+
+#if BLOCK_SIZE == 16
+        setSprt16(&cell->sprite);
+#else
+        setSprt(&cell->sprite);
+        setWH(&cell->sprite, BLOCK_SIZE, BLOCK_SIZE);
+#endif
+        setXY0(&cell->sprite, x * BLOCK_SIZE, y * BLOCK_SIZE);
+        setUV0(&cell->sprite, 0, 0);
+        setRGB0(&cell->sprite, 128, 128, 128);
+        cell->sprite.clut = BLOCK_CLUT;
+
+        setTile(&cell->clear);
+        setXY0(&cell->clear, x * BLOCK_SIZE, y * BLOCK_SIZE);
+        setWH(&cell->clear, BLOCK_SIZE, BLOCK_SIZE);
+        setRGB0(&cell->clear, 0, 0, 0);
       }
     }
   }
+}
 
-  // 3. Draw Active Player
-  drawActiveBlock(4);
+// Links the retained packets of one cell, with the look patched in
+static inline void linkCell(CellPackets *cell, int type, int style, int z_index) {
+  if (type > 0) {
+    cell->sprite.u0 = cellU(type, style);
+    addPrim(ot[db][z_index], &cell->sprite);
+  }
+  addPrim(ot[db][z_index], &cell->clear); // Added last, so it runs first
+}
 
-  // 4. Draw Lines/UI
-  drawGridLines(3, 5);
+// Redraws changed cells into the cache, between a switch to the cache's
+// draw area and one back to the frame's. Links nothing if nothing changed.
+static int updateBoardCache(const Board *board, BoardPackets *packets, int z_index) {
+  int redrawn = 0;
+
+  for (int x = 0; x < GRID_W; x++) {
+    u_short changed = (board->colorA[x] ^ cachedA[x]) | (board->colorB[x] ^ cachedB[x]) |
+                      (board->chain[x] ^ cachedChain[x]) | (board->marked[x] ^ cachedMarked[x]);
+    if (cacheStale)
+      changed = COLUMN_MASK;
+    if (!changed)
+      continue;
+
+    // Added first, so it runs after the cells
+    if (!redrawn)
+      addPrim(ot[db][z_index], &packets->toFrame);
+
+    for (int y = 0; changed; y++, changed >>= 1) {
+      if (!(changed & 1))
+        continue;
+
+      linkCell(&packets->cells[x][y], getCellType(board, x, y), (board->marked[x] >> y) & 1, z_index);
+      redrawn++;
+    }
+
+    cachedA[x] = board->colorA[x];
+    cachedB[x] = board->colorB[x];
+    cachedChain[x] = board->chain[x];
+    cachedMarked[x] = board->marked[x];
+  }
+  cacheStale = 0;
+
+  if (redrawn)
+    addPrim(ot[db][z_index], &packets->toCache);
+  return redrawn;
+}
+
+static void linkBoardCache(BoardPackets *packets, int z_index) {
+  for (int i = 0; i < CACHE_STRIPS; i++) {
+    addPrim(ot[db][z_index], &packets->strip[i]);
+    addPrim(ot[db][z_index], &packets->stripPage[i]);
+  }
+}
+
+#if PERF_HUD
+static u_short immediateCellTicks = 0;
+static u_short retainedCellTicks = 0;
+
+// Cost of putting every cell of a full board into the OT, with packets
+// built from scratch and with retained packets relinked. Both are unlinked
+// again, so nothing is drawn. Runs before the cache links this frame's cells.
+static void benchmarkCells(BoardPackets *packets, int z_index) {
+  u_long head = ot[db][z_index];
+  char *start = nextpri;
+
+  u_short begin = Perf_Now();
+  for (int x = 0; x < GRID_W; x++) {
+    for (int y = 0; y < GRID_H; y++) {
+      Draw_RawBlock(x * BLOCK_SIZE, y * BLOCK_SIZE, 1, BLOCK_STYLE_NORMAL, z_index);
+      Draw_Rect(x * BLOCK_SIZE, y * BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, 0, 0, 0, z_index);
+    }
+  }
+  immediateCellTicks = Perf_Since(begin);
+  ot[db][z_index] = head;
+  nextpri = start;
+
+  begin = Perf_Now();
+  for (int x = 0; x < GRID_W; x++) {
+    for (int y = 0; y < GRID_H; y++) {
+      linkCell(&packets->cells[x][y], 1, BLOCK_STYLE_NORMAL, z_index);
+    }
+  }
+  retainedCellTicks = Perf_Since(begin);
+  ot[db][z_index] = head;
+}
+#endif
+
+void Grid_Draw(const Board *board) {
+  BoardPackets *packets = &boardPackets[db];
+
+  // 1. Draw Background, Grid and Lines
+  addPrim(ot[db][7], &packets->backdrop);
+
+  // 2. Draw Settled Cells
+#if PERF_HUD
+  benchmarkCells(packets, 6);
+#endif
+  cacheRedraws = updateBoardCache(board, packets, 6);
+  linkBoardCache(packets, 5);
+
+  // 3. Draw Active Player and Queue
+  drawActiveBlock(board, 4);
+  drawQueue(board, 4);
+  Draw_TexPage(BLOCK_TPAGE, 4); // Added last, so it comes before the blocks
+
+  // 4. Draw Timeline
+  drawTimeline(board, 2);
 
-  // 5. Draw Timeline
-  drawTimeline(2);
+  FntPrint("Score: %d\n", board->score);
+  FntPrint("Squares: %d\n", board->squareCount);
 
-  FntPrint("Score: %d\n", score);
+#if PERF_HUD
+  FntPrint("Validate: %d Cache: %d\n", validateTicks, cacheRedraws);
+  FntPrint("Cells: built %d relinked %d\n", immediateCellTicks, retainedCellTicks);
+#endif
 }
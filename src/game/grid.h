@@ -3,19 +3,131 @@
 
 #include "../core/system.h"
 #include "player.h" // Needed for PlaceBlock
+#include "events.h"
 
+// Board Geometry
+// Picked at build time (make BOARD_MODE=VERSUS), so every kernel is compiled
+// for one size with constant bounds and nothing branches on dimensions.
+#define BOARD_MODE_ARCADE 0 // 16x10
+#define BOARD_MODE_VERSUS 1 // 8x10, a single centered board
+#define BOARD_MODE_WIDE   2 // 24x10 puzzle
+
+#ifndef BOARD_MODE
+#define BOARD_MODE BOARD_MODE_ARCADE
+#endif
+
+#if BOARD_MODE == BOARD_MODE_VERSUS
+#define BLOCK_SIZE  16
+#define GRID_W      8
+#define GRID_H      10
+#elif BOARD_MODE == BOARD_MODE_WIDE
+#define BLOCK_SIZE  12 // 24 columns of 16px would not fit on screen
+#define GRID_W      24
+#define GRID_H      10
+#else
 #define BLOCK_SIZE  16
 #define GRID_W      16
 #define GRID_H      10
+#endif
+
+_Static_assert(GRID_H <= 16, "A column of cells must fit in a u_short");
+_Static_assert(GRID_W <= 32, "A row of columns must fit in a ColumnSet");
+
+// One bit per column
+#if GRID_W <= 16
+typedef u_short ColumnSet;
+#else
+typedef u_long ColumnSet;
+#endif
+
+// Loops with a GRID_W or GRID_H trip count are fully unrolled
+#define GRID_UNROLL _Pragma("GCC unroll 32")
+
+// Timeline position is an exact fraction of a column: every tick adds
+// bpm * TIMELINE_COLUMNS_PER_BEAT and a column is crossed each
+// TIMELINE_COLUMN_UNITS (one minute of ticks), so crossings land on exact
+// beat fractions and the sweep never drifts from the tempo.
+#define TIMELINE_COLUMNS_PER_BEAT 2
+#define TIMELINE_COLUMN_UNITS (60 * TICKS_PER_SECOND)
+#define TIMELINE_DEFAULT_BPM 120
+
+#define PIECE_QUEUE_LENGTH 3 // Upcoming pieces shown on the HUD
+
+// Cell values hold the color in the low bits, plus a flag for chain blocks
+#define CELL_COLOR_MASK 3
+#define CELL_CHAIN      4 // Clears every connected block of its color
+
+// Complete state of one playfield. Plain data without pointers, so a
+// board can be copied, snapshotted or searched with a struct assignment.
+// Per-column arrays come first and single values after them, up to
+// events; rewind.c relies on that layout.
+//
+// Cells are stored as bitplanes: one word per column and plane, bit y set
+// means row y (GRID_H must fit in 16 bits). A cell's type is 1 if its bit
+// is set in colorA, 2 if set in colorB, 0 otherwise, with CELL_CHAIN added
+// if it is also set in chain.
+struct Board {
+    u_short colorA[GRID_W];        // Color A cells
+    u_short colorB[GRID_W];        // Color B cells
+    u_short marked[GRID_W];        // Cells that are part of a 2x2 square
+    u_short protected[GRID_W];     // Cells that wait for the next timeline pass
+    u_short squares[GRID_W];       // Bit y set means a square with its top-left at (x, y)
+    u_short chain[GRID_W];         // Chain blocks
+    u_short linked[GRID_W];        // Cells joined to a marked chain block, marked until swept
+    signed char columnTop[GRID_W]; // Row of the highest block per column, GRID_H if empty
+    int squareCount;               // Distinct squares currently on the board
+    u_int cellHash;                // Zobrist hash of every per-column plane but columnTop
+
+    // Cells changed since the last match validation, as a row mask and a column range
+    u_short dirtyRows;
+    short dirtyMinX;
+    short dirtyMaxX;
+
+    // Physics
+    ColumnSet unsettledColumns; // Bit x set means column x may have falling blocks
+    short gravityTimer;
+
+    // Timeline
+    short timelineGridX;
+    short timelineBpm;
+    int timelinePhase; // Progress through the current column, in TIMELINE_COLUMN_UNITS
+    ColumnSet sweptColumns; // Columns erased by the current group, not yet falling
+
+    // Score
+    int score;
+    int timelineSquareCount;
+
+    ActivePiece player;
+    int gameOver;
+
+    // Piece generator, xorshift32 (u_int is 32 bits on console and host)
+    u_int seed;
+    u_int rngState;
+    int pieceQueue[PIECE_QUEUE_LENGTH][4]; // Cells of the next pieces
+    short pieceQueueHead;                  // Slot of the very next piece
+
+    EventRing events; // Written by the logic, drained by the session
+
+    // Columns whose arrays changed since the owner last cleared this
+    ColumnSet touchedColumns;
+};
+
+#define ALL_COLUMNS ((ColumnSet)((1ULL << GRID_W) - 1))
 
-void Grid_Init(void);
-void Grid_Update(void);
-void Grid_Draw(void);
+void Grid_InitGraphics(void);
+void Grid_Init(Board *board, u_int seed);
+void Grid_Clone(Board *dst, const Board *src);
+void Grid_Update(Board *board);
+void Grid_Settle(Board *board);
+void Grid_Draw(const Board *board);
 void Grid_SetTheme(int themeIndex);
+void Grid_SetTempo(Board *board, int bpm);
 
-int Grid_IsMoveValid(int x, int y);
-void Grid_PlaceBlock(ActivePiece* p);
+int Grid_IsMoveValid(const Board *board, int x, int y);
+u_int Grid_Checksum(const Board *board);
+int Grid_GetLandingY(const Board *board, int x, int y);
+void Grid_PlaceBlock(Board *board, const ActivePiece *p);
 
-int GetScore(void);
+int GetScore(const Board *board);
 
 #endif
@@ -0,0 +1,198 @@
+#include "opponent.h"
+#include "session.h"
+#include "../core/jobs.h"
+
+// A move is a column and a number of clockwise turns
+#define MOVE_COUNT ((GRID_W - 1) * 4)
+#define MOVE_X(move) ((move) >> 2)
+#define MOVE_TURNS(move) ((move) & 3)
+
+#define SPAWN_Y -2 // See Player_Init
+
+// The current piece plus every queued one
+#define MAX_DEPTH (1 + PIECE_QUEUE_LENGTH)
+
+#define SQUARE_WEIGHT 64
+#define PAIR_WEIGHT   4
+#define HEIGHT_WEIGHT 1
+#define DEAD_SCORE    (-0x10000000)
+
+// Iterative deepening over every sequence of moves for the next pieces.
+// Each depth is searched in full before its best first move is used.
+typedef struct {
+    Board boards[MAX_DEPTH + 1]; // boards[d + 1] is boards[d] after move[d]
+    int pieces[MAX_DEPTH][4];
+    short move[MAX_DEPTH];
+    int depth;
+    int built; // Levels whose board is up to date with move[]
+    int dead;  // Level + 1 at which the sequence topped out, 0 if alive
+
+    int bestScore;
+    int bestMove;
+
+    int chosenMove; // From the deepest finished depth, -1 until depth 1 is done
+    int turns;      // Clockwise turns sent for this piece
+    u_int rootState; // Generator state when the search started, tells pieces apart
+} Search;
+
+static Search search;
+static Job searchJob;
+
+static int popCount(u_short mask) {
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+// Drops the piece at the move's column and lets the blocks settle.
+// Returns 0 if it tops out.
+static int place(Board *board, const int *cells, int move) {
+    ActivePiece *piece = &board->player;
+
+    for (int i = 0; i < 4; i++) piece->cells[i] = cells[i];
+    for (int r = MOVE_TURNS(move); r > 0; r--) Player_RotateCW(board);
+
+    piece->gridX = MOVE_X(move);
+    piece->gridY = Grid_GetLandingY(board, piece->gridX, SPAWN_Y);
+    if (piece->gridY < -1) return 0;
+
+    Grid_PlaceBlock(board, piece);
+    Grid_Settle(board);
+    return 1;
+}
+
+// Squares made, same colored neighbours that could become squares, and a
+// penalty that grows quickly with the height of each column
+static int evaluate(const Board *board) {
+    int score = board->squareCount * SQUARE_WEIGHT;
+
+    for (int x = 0; x < GRID_W; x++) {
+        u_short a = board->colorA[x];
+        u_short b = board->colorB[x];
+        int pairs = popCount(a & (a >> 1)) + popCount(b & (b >> 1));
+        if (x < GRID_W - 1) {
+            pairs += popCount(a & board->colorA[x + 1]) + popCount(b & board->colorB[x + 1]);
+        }
+
+        int height = GRID_H - board->columnTop[x];
+        score += pairs * PAIR_WEIGHT - height * height * HEIGHT_WEIGHT;
+    }
+    return score;
+}
+
+static void startDepth(Search *s) {
+    for (int d = 0; d < s->depth; d++) s->move[d] = 0;
+    s->move[s->depth - 1] = -1;
+    s->built = 0;
+    s->bestScore = DEAD_SCORE - 1;
+}
+
+// Steps to the next sequence, rebuilding boards from the first level that
+// changed. Returns 0 once every sequence of this depth has been tried.
+static int nextSequence(Search *s) {
+    int d = s->depth - 1;
+    while (d >= 0 && ++s->move[d] == MOVE_COUNT) {
+        s->move[d] = 0;
+        d--;
+    }
+    if (d < 0) return 0;
+    if (d > s->built) d = s->built;
+
+    s->dead = 0;
+    for (; d < s->depth; d++) {
+        Grid_Clone(&s->boards[d + 1], &s->boards[d]);
+        if (!place(&s->boards[d + 1], s->pieces[d], s->move[d])) {
+            // Nothing below a lost board is worth trying
+            s->dead = d + 1;
+            for (int k = d + 1; k < s->depth; k++) s->move[k] = MOVE_COUNT - 1;
+            break;
+        }
+    }
+    s->built = d;
+    return 1;
+}
+
+static int searchStep(Job *job) {
+    Search *s = job->data;
+
+    JOB_BEGIN(job);
+    for (s->depth = 1; s->depth <= MAX_DEPTH; s->depth++) {
+        startDepth(s);
+        while (nextSequence(s)) {
+            // Losing later is better than losing now
+            int score = s->dead ? DEAD_SCORE + s->dead : evaluate(&s->boards[s->depth]);
+            if (score > s->bestScore) {
+                s->bestScore = score;
+                s->bestMove = s->move[0];
+            }
+            JOB_YIELD(job);
+        }
+        s->chosenMove = s->bestMove;
+    }
+    JOB_END(job);
+}
+
+static void startSearch(const Board *board) {
+    Jobs_Cancel(&searchJob);
+
+    Grid_Clone(&search.boards[0], board);
+    Grid_Settle(&search.boards[0]);
+
+    for (int i = 0; i < 4; i++) search.pieces[0][i] = board->player.cells[i];
+    for (int d = 1; d < MAX_DEPTH; d++) {
+        const int *next = board->pieceQueue[(board->pieceQueueHead + d - 1) % PIECE_QUEUE_LENGTH];
+        for (int i = 0; i < 4; i++) search.pieces[d][i] = next[i];
+    }
+
+    search.chosenMove = -1;
+    search.turns = 0;
+    search.rootState = board->rngState;
+    Jobs_Start(&searchJob);
+}
+
+void Opponent_Init(int budget) {
+    Jobs_Cancel(&searchJob);
+
+    searchJob.name = "Opponent";
+    searchJob.run = searchStep;
+    searchJob.data = &search;
+    searchJob.frameBudget = budget;
+
+    search.rootState = 0;
+    search.chosenMove = -1;
+}
+
+void Opponent_Stop(void) {
+    Jobs_Cancel(&searchJob);
+}
+
+// Turns and steps towards the chosen move, then slams once the search is
+// over or the piece is about to enter the board
+int Opponent_Update(const Board *board) {
+    const ActivePiece *piece = &board->player;
+    if (!piece->active || board->gameOver) return 0;
+
+    if (board->rngState != search.rootState) startSearch(board);
+    if (search.chosenMove < 0) return 0;
+
+    int move = search.chosenMove;
+    int actions = 0;
+
+    if ((search.turns & 3) != MOVE_TURNS(move)) {
+        actions |= ACTION_ROTATE_CW;
+        search.turns++;
+    }
+
+    if (piece->gridX < MOVE_X(move)) {
+        actions |= ACTION_MOVE_RIGHT;
+    } else if (piece->gridX > MOVE_X(move)) {
+        actions |= ACTION_MOVE_LEFT;
+    } else if (!actions && (!searchJob.running || piece->gridY >= 0)) {
+        Jobs_Cancel(&searchJob);
+        actions |= ACTION_SLAM | ACTION_SLAM_UP;
+    }
+    return actions;
+}
@@ -0,0 +1,19 @@
+#ifndef GAME_OPPONENT_H
+#define GAME_OPPONENT_H
+
+#include "grid.h"
+#include "../core/perf.h"
+
+// Difficulty is the search time the opponent gets each frame, in root
+// counter 2 ticks. The search runs as a job in the frame's spare time.
+#define OPPONENT_EASY   (PERF_TICKS_PER_MS / 4)
+#define OPPONENT_NORMAL (PERF_TICKS_PER_MS)
+#define OPPONENT_HARD   (PERF_TICKS_PER_MS * 4)
+
+void Opponent_Init(int budget);
+void Opponent_Stop(void);
+
+// Session actions (ACTION_*) for this tick
+int Opponent_Update(const Board *board);
+
+#endif
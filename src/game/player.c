@@ -1,107 +1,156 @@
 #include "player.h"
 #include "grid.h" // Needs to know about grid boundaries
 #include <libgte.h>
-#include <stdlib.h> // for rand()
-#include "../core/statemanager.h"
-
-ActivePiece player;
 
 static const int BLOCK_PATTERNS[][4] = {
     {1, 1, 1, 1}, {2, 2, 2, 2},
     {1, 2, 1, 2}, {1, 1, 2, 2},
     {1, 2, 2, 1}, {2, 1, 1, 2},
     {1, 1, 1, 2}, {2, 2, 2, 1},
+
+    // Chain blocks, kept last
+    {1 | CELL_CHAIN, 1, 2, 1}, {2 | CELL_CHAIN, 2, 1, 2},
 };
 #define PATTERN_COUNT (sizeof(BLOCK_PATTERNS) / sizeof(BLOCK_PATTERNS[0]))
+#define CHAIN_PATTERN_COUNT 2
+#define CHAIN_CHANCE 16 // One piece in 16 carries a chain block
+
+#define DEFAULT_SEED 0x2545F491 // xorshift state must never be zero
+
+// xorshift32, the same sequence on every platform for a given seed
+static u_int nextRandom(Board *board) {
+    u_int x = board->rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    board->rngState = x;
+    return x >> 8; // Low bits are the weakest
+}
+
+static void rollPiece(Board *board, int *cells) {
+    int p = nextRandom(board) % (PATTERN_COUNT - CHAIN_PATTERN_COUNT);
+    if (nextRandom(board) % CHAIN_CHANCE == 0) {
+        p = PATTERN_COUNT - CHAIN_PATTERN_COUNT + nextRandom(board) % CHAIN_PATTERN_COUNT;
+    }
+    cells[0] = BLOCK_PATTERNS[p][0];
+    cells[1] = BLOCK_PATTERNS[p][1];
+    cells[2] = BLOCK_PATTERNS[p][2];
+    cells[3] = BLOCK_PATTERNS[p][3];
+}
+
+// Restarts the generator and refills the queue
+void Player_Seed(Board *board, u_int seed) {
+    board->seed = seed;
+    board->rngState = seed ? seed : DEFAULT_SEED;
+    board->pieceQueueHead = 0;
+    for (int i = 0; i < PIECE_QUEUE_LENGTH; i++) {
+        rollPiece(board, board->pieceQueue[i]);
+    }
+}
+
+void Player_Init(Board *board) {
+    ActivePiece *player = &board->player;
 
-void Player_Init(void) {
-    player.active = 1;
-    player.gridX = (GRID_W / 2) - 1;
-    player.gridY = -2; // Start above board
-    player.dropTimer = 0;
-    player.dropLock = 0;
-    player.graceCycles = 3;
-
-    int p = rand() % PATTERN_COUNT;
-    player.cells[0] = BLOCK_PATTERNS[p][0];
-    player.cells[1] = BLOCK_PATTERNS[p][1];
-    player.cells[2] = BLOCK_PATTERNS[p][2];
-    player.cells[3] = BLOCK_PATTERNS[p][3];
+    player->active = 1;
+    player->gridX = (GRID_W / 2) - 1;
+    player->gridY = -2; // Start above board
+    player->dropTimer = 0;
+    player->dropLock = 0;
+    player->graceCycles = 3;
+
+    // Take the next piece and roll a new one into its slot
+    int *next = board->pieceQueue[board->pieceQueueHead];
+    player->cells[0] = next[0];
+    player->cells[1] = next[1];
+    player->cells[2] = next[2];
+    player->cells[3] = next[3];
+    rollPiece(board, next);
+    board->pieceQueueHead = (board->pieceQueueHead + 1) % PIECE_QUEUE_LENGTH;
 }
 
-void Player_Update(void) {
-    if(!player.active) {
-        Player_Init();
+void Player_Update(Board *board) {
+    ActivePiece *player = &board->player;
+
+    if(!player->active) {
+        Player_Init(board);
         return;
     }
 
     // Handle Drop Timer
-    if (player.dropLock) {
+    if (player->dropLock) {
         // Slam logic
-        while (Grid_IsMoveValid(player.gridX, player.gridY + 1)) {
-            player.gridY++;
-        }
-        player.dropTimer = DROP_DELAY_FRAMES + 1; // Force landing next check
+        player->gridY = Grid_GetLandingY(board, player->gridX, player->gridY);
+        player->dropTimer = DROP_DELAY_TICKS + 1; // Force landing next check
     } else {
-        player.dropTimer++;
+        player->dropTimer++;
     }
 
     // Handle Gravity Tick
-    if (player.dropTimer >= DROP_DELAY_FRAMES) {
-        player.dropTimer = 0;
+    if (player->dropTimer >= DROP_DELAY_TICKS) {
+        player->dropTimer = 0;
 
-        if (player.graceCycles > 0) {
-            player.graceCycles--;
+        if (player->graceCycles > 0) {
+            player->graceCycles--;
             return;
         }
 
-        if (Grid_IsMoveValid(player.gridX, player.gridY + 1)) {
-            player.gridY++;
+        if (Grid_IsMoveValid(board, player->gridX, player->gridY + 1)) {
+            player->gridY++;
         } else {
             // Landed
-            if (player.gridY < -1) {
-                StateManager_ChangeState(STATE_GAMEOVER);
+            if (player->gridY < -1) {
+                board->gameOver = 1;
+                Events_Push(&board->events, EVENT_GAME_OVER, player->gridX, board->score);
                 return;
             }
-            Grid_PlaceBlock(&player);
+            Grid_PlaceBlock(board, player);
+            player->active = 0;
         }
     }
 }
 
 // Movement Wrappers
-void Player_MoveLeft(void) {
-    if (Grid_IsMoveValid(player.gridX - 1, player.gridY)) {
-        player.gridX--;
+void Player_MoveLeft(Board *board) {
+    ActivePiece *player = &board->player;
+
+    if (Grid_IsMoveValid(board, player->gridX - 1, player->gridY)) {
+        player->gridX--;
     }
 }
 
-void Player_MoveRight(void) {
-    if (Grid_IsMoveValid(player.gridX + 1, player.gridY)) {
-        player.gridX++;
+void Player_MoveRight(Board *board) {
+    ActivePiece *player = &board->player;
+
+    if (Grid_IsMoveValid(board, player->gridX + 1, player->gridY)) {
+        player->gridX++;
     }
 }
 
-void Player_SlamBlock(void) {
-    if (player.slamLatch) return;
-    player.dropLock = 1;
-    player.slamLatch = 1;
+void Player_SlamBlock(Board *board) {
+    ActivePiece *player = &board->player;
+
+    if (player->slamLatch) return;
+    player->dropLock = 1;
+    player->slamLatch = 1;
 }
 
-void Player_UnlockDrop(void) {
-    player.slamLatch = 0;
+void Player_UnlockDrop(Board *board) {
+    board->player.slamLatch = 0;
 }
 
 // Rotation Logic
-void Player_RotateCW(void) {
-    int c0 = player.cells[0]; int c1 = player.cells[1];
-    int c2 = player.cells[2]; int c3 = player.cells[3];
-    player.cells[0] = c2; player.cells[1] = c0;
-    player.cells[2] = c3; player.cells[3] = c1;
+void Player_RotateCW(Board *board) {
+    int *cells = board->player.cells;
+    int c0 = cells[0]; int c1 = cells[1];
+    int c2 = cells[2]; int c3 = cells[3];
+    cells[0] = c2; cells[1] = c0;
+    cells[2] = c3; cells[3] = c1;
 }
 
-void Player_RotateCCW(void) {
-    int c0 = player.cells[0]; int c1 = player.cells[1];
-    int c2 = player.cells[2]; int c3 = player.cells[3];
-    player.cells[0] = c1; player.cells[1] = c3;
-    player.cells[2] = c0; player.cells[3] = c2;
+void Player_RotateCCW(Board *board) {
+    int *cells = board->player.cells;
+    int c0 = cells[0]; int c1 = cells[1];
+    int c2 = cells[2]; int c3 = cells[3];
+    cells[0] = c1; cells[1] = c3;
+    cells[2] = c0; cells[3] = c2;
 }
@@ -1,8 +1,10 @@
 #ifndef GAME_PLAYER_H
 #define GAME_PLAYER_H
 
+#include <sys/types.h>
+
 // Helper constants
-#define DROP_DELAY_FRAMES 30
+#define DROP_DELAY_TICKS MS_TO_TICKS(500)
 
 typedef struct {
     int gridX;
@@ -15,18 +17,19 @@ typedef struct {
     int graceCycles; // Frames to ignore gravity at spawn
 } ActivePiece;
 
-// Accessor for drawing
-extern ActivePiece player;
+// Each board owns its piece, see grid.h
+typedef struct Board Board;
 
-void Player_Init(void);
-void Player_Update(void); // New consolidated update function
+void Player_Seed(Board *board, u_int seed);
+void Player_Init(Board *board);
+void Player_Update(Board *board); // New consolidated update function
 
 // Input Commands
-void Player_MoveLeft(void);
-void Player_MoveRight(void);
-void Player_SlamBlock(void);
-void Player_RotateCW(void);
-void Player_RotateCCW(void);
-void Player_UnlockDrop(void);
+void Player_MoveLeft(Board *board);
+void Player_MoveRight(Board *board);
+void Player_SlamBlock(Board *board);
+void Player_RotateCW(Board *board);
+void Player_RotateCCW(Board *board);
+void Player_UnlockDrop(Board *board);
 
 #endif
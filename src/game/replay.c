@@ -0,0 +1,92 @@
+#include "replay.h"
+
+#define MEMCARD_BLOCK_SIZE 8192
+
+_Static_assert(sizeof(Replay) <= MEMCARD_BLOCK_SIZE, "A replay must fit one memory card block");
+
+static Replay replay;
+
+// Playback position
+static int cursorRun = 0;
+static int cursorTick = 0;
+
+void Replay_StartRecording(u_int seed) {
+    replay.seed = seed;
+    replay.runCount = 0;
+    replay.truncated = 0;
+    replay.runs[0].idle = 0;
+}
+
+void Replay_Record(int actions) {
+    if (replay.truncated) return;
+
+    ReplayRun *run = &replay.runs[replay.runCount];
+    if (!actions && run->idle < REPLAY_MAX_IDLE) {
+        run->idle++;
+        return;
+    }
+
+    // This tick closes the run, with no actions if the idle count is full
+    if (replay.runCount + 1 >= REPLAY_MAX_RUNS) {
+        replay.truncated = 1;
+        return;
+    }
+    run->actions = actions;
+    replay.runCount++;
+    replay.runs[replay.runCount].idle = 0;
+}
+
+// Drops everything after the first ticks, e.g. a future that was rewound
+void Replay_Truncate(u_int ticks) {
+    u_int tick = 0;
+
+    for (int i = 0; i < replay.runCount; i++) {
+        ReplayRun *run = &replay.runs[i];
+        if (tick + run->idle >= ticks) {
+            // The cut falls before this run's action, it becomes the trailing run
+            run->idle = ticks - tick;
+            replay.runCount = i;
+            replay.truncated = 0;
+            return;
+        }
+        tick += run->idle + 1;
+    }
+
+    // Within the trailing idle ticks, past them nothing was recorded
+    ReplayRun *run = &replay.runs[replay.runCount];
+    if (ticks - tick <= run->idle) {
+        run->idle = ticks - tick;
+        replay.truncated = 0;
+    }
+}
+
+void Replay_StartPlayback(void) {
+    cursorRun = 0;
+    cursorTick = 0;
+}
+
+int Replay_Next(int *actions) {
+    const ReplayRun *run = &replay.runs[cursorRun];
+
+    if (cursorTick < run->idle) {
+        cursorTick++;
+        *actions = 0;
+        return 1;
+    }
+
+    // Trailing idle ticks were the last thing recorded
+    if (cursorRun >= replay.runCount) return 0;
+
+    *actions = run->actions;
+    cursorRun++;
+    cursorTick = 0;
+    return 1;
+}
+
+const Replay *Replay_Get(void) {
+    return &replay;
+}
+
+int Replay_Size(void) {
+    return (int)(sizeof(Replay) - sizeof(replay.runs)) + (replay.runCount + 1) * (int)sizeof(ReplayRun);
+}
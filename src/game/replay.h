@@ -0,0 +1,35 @@
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+#include <sys/types.h>
+
+// A game is its seed plus the actions of every tick, run-length encoded:
+// each run is a count of idle ticks followed by one tick of actions. A
+// press costs two bytes and idle time two bytes per 256 ticks, so ten
+// minutes of play takes a few KB and the buffer fits one memory card block.
+#define REPLAY_MAX_RUNS 4000
+#define REPLAY_MAX_IDLE 255
+
+typedef struct {
+    u_char idle;    // Ticks without actions before this one
+    u_char actions; // ACTION_* bits, see session.h
+} ReplayRun;
+
+typedef struct {
+    u_int seed;
+    u_short runCount;  // Complete runs, runs[runCount] holds the trailing idle ticks
+    u_short truncated; // Buffer filled up before the game ended
+    ReplayRun runs[REPLAY_MAX_RUNS];
+} Replay;
+
+void Replay_StartRecording(u_int seed);
+void Replay_Record(int actions);
+void Replay_Truncate(u_int ticks); // Keeps the first ticks, recording goes on from there
+
+void Replay_StartPlayback(void);
+int Replay_Next(int *actions); // Returns 0 past the last recorded tick
+
+const Replay *Replay_Get(void);
+int Replay_Size(void); // Bytes in use
+
+#endif
@@ -0,0 +1,210 @@
+#include "rewind.h"
+#include <stddef.h>
+#include <string.h>
+
+#define KEYFRAME_COUNT (REWIND_TICKS / REWIND_KEYFRAME_INTERVAL + 1)
+#define STREAM_MASK (REWIND_DELTA_BYTES - 1)
+
+_Static_assert((REWIND_DELTA_BYTES & STREAM_MASK) == 0, "REWIND_DELTA_BYTES must be a power of two");
+
+// Per-column arrays, each copied as one element per touched column
+typedef struct {
+    u_short offset;
+    u_short size;
+} ColumnField;
+
+static const ColumnField COLUMN_FIELDS[] = {
+    {offsetof(Board, colorA), sizeof(u_short)},
+    {offsetof(Board, colorB), sizeof(u_short)},
+    {offsetof(Board, marked), sizeof(u_short)},
+    {offsetof(Board, protected), sizeof(u_short)},
+    {offsetof(Board, squares), sizeof(u_short)},
+    {offsetof(Board, chain), sizeof(u_short)},
+    {offsetof(Board, linked), sizeof(u_short)},
+    {offsetof(Board, columnTop), sizeof(signed char)},
+};
+#define COLUMN_FIELD_COUNT (sizeof(COLUMN_FIELDS) / sizeof(COLUMN_FIELDS[0]))
+
+_Static_assert(offsetof(Board, squareCount) == offsetof(Board, columnTop) + GRID_W,
+               "Every per-column array must be listed in COLUMN_FIELDS");
+
+// Single values, diffed as words against the previous tick
+#define SCALARS_BEGIN offsetof(Board, squareCount)
+#define SCALARS_END   offsetof(Board, events)
+#define SCALAR_WORDS  ((SCALARS_END - SCALARS_BEGIN) / sizeof(u_int))
+
+_Static_assert(SCALARS_BEGIN % sizeof(u_int) == 0 && SCALARS_END % sizeof(u_int) == 0,
+               "Board values must be word aligned");
+_Static_assert(SCALAR_WORDS < 256, "Word indices are bytes");
+
+typedef struct {
+    int tick;        // -1 when unused
+    u_int streamPos; // Deltas of the following ticks start here
+    Board board;
+} Keyframe;
+
+static Keyframe keyframes[KEYFRAME_COUNT];
+static u_int lastScalars[SCALAR_WORDS];
+
+// Deltas, a byte ring addressed by ever increasing positions. A seek moves
+// writePos back, but bytes up to highWater were written all the same, so
+// only positions within one ring of highWater are still intact.
+static u_char stream[REWIND_DELTA_BYTES];
+static u_int writePos = 0;
+static u_int highWater = 0;
+
+static int currentTick = 0;
+
+static inline u_int *scalarWords(Board *board) {
+    return (u_int *)((char *)board + SCALARS_BEGIN);
+}
+
+// Byte copies, records are packed and may wrap around the ring
+static void putBytes(const void *src, int size) {
+    const u_char *bytes = src;
+    for (int i = 0; i < size; i++) {
+        stream[writePos++ & STREAM_MASK] = bytes[i];
+    }
+}
+
+static void getBytes(u_int *pos, void *dst, int size) {
+    u_char *bytes = dst;
+    for (int i = 0; i < size; i++) {
+        bytes[i] = stream[(*pos)++ & STREAM_MASK];
+    }
+}
+
+static void storeKeyframe(const Board *board) {
+    Keyframe *key = &keyframes[(currentTick / REWIND_KEYFRAME_INTERVAL) % KEYFRAME_COUNT];
+    key->tick = currentTick;
+    key->streamPos = writePos;
+    key->board = *board;
+}
+
+// Touched columns, then a count and (index, value) pairs of changed words
+static void writeDelta(Board *board) {
+    ColumnSet touched = board->touchedColumns;
+    putBytes(&touched, sizeof(touched));
+
+    for (int x = 0; touched; x++, touched >>= 1) {
+        if (!(touched & 1)) continue;
+        for (int f = 0; f < COLUMN_FIELD_COUNT; f++) {
+            const ColumnField *field = &COLUMN_FIELDS[f];
+            putBytes((char *)board + field->offset + x * field->size, field->size);
+        }
+    }
+
+    const u_int *words = scalarWords(board);
+    u_char changed = 0;
+    for (int i = 0; i < SCALAR_WORDS; i++) {
+        if (words[i] != lastScalars[i]) changed++;
+    }
+    putBytes(&changed, 1);
+    for (u_char i = 0; i < SCALAR_WORDS; i++) {
+        if (words[i] == lastScalars[i]) continue;
+        putBytes(&i, 1);
+        putBytes(&words[i], sizeof(u_int));
+    }
+}
+
+static void applyDelta(Board *board, u_int *pos) {
+    ColumnSet touched;
+    getBytes(pos, &touched, sizeof(touched));
+    touched &= ALL_COLUMNS; // Never write past the board, whatever was read
+
+    for (int x = 0; touched; x++, touched >>= 1) {
+        if (!(touched & 1)) continue;
+        for (int f = 0; f < COLUMN_FIELD_COUNT; f++) {
+            const ColumnField *field = &COLUMN_FIELDS[f];
+            getBytes(pos, (char *)board + field->offset + x * field->size, field->size);
+        }
+    }
+
+    u_int *words = scalarWords(board);
+    u_char changed;
+    getBytes(pos, &changed, 1);
+    while (changed--) {
+        u_char index;
+        u_int value;
+        getBytes(pos, &index, 1);
+        getBytes(pos, &value, sizeof(u_int));
+        if (index < SCALAR_WORDS) words[index] = value;
+    }
+}
+
+void Rewind_Reset(Board *board) {
+    for (int i = 0; i < KEYFRAME_COUNT; i++) {
+        keyframes[i].tick = -1;
+    }
+    currentTick = 0;
+    writePos = 0;
+    highWater = 0;
+
+    storeKeyframe(board);
+    memcpy(lastScalars, scalarWords(board), sizeof(lastScalars));
+    board->touchedColumns = 0;
+}
+
+void Rewind_Record(Board *board) {
+    currentTick++;
+
+    if (currentTick % REWIND_KEYFRAME_INTERVAL == 0) {
+        storeKeyframe(board);
+    } else {
+        writeDelta(board);
+        if (writePos > highWater) highWater = writePos;
+    }
+
+    memcpy(lastScalars, scalarWords(board), sizeof(lastScalars));
+    board->touchedColumns = 0;
+}
+
+// Oldest keyframe whose deltas have not been overwritten yet
+int Rewind_Available(void) {
+    int oldest = currentTick;
+
+    for (int i = 0; i < KEYFRAME_COUNT; i++) {
+        const Keyframe *key = &keyframes[i];
+        if (key->tick < 0 || key->tick > currentTick) continue;
+        if (highWater - key->streamPos > REWIND_DELTA_BYTES) continue;
+        if (key->tick < oldest) oldest = key->tick;
+    }
+
+    int available = currentTick - oldest;
+    return (available < REWIND_TICKS) ? available : REWIND_TICKS;
+}
+
+int Rewind_Seek(Board *board, int ticks) {
+    int available = Rewind_Available();
+    if (ticks > available) ticks = available;
+    if (ticks <= 0) return 0;
+
+    int target = currentTick - ticks;
+    Keyframe *key = &keyframes[(target / REWIND_KEYFRAME_INTERVAL) % KEYFRAME_COUNT];
+    if (key->tick != target - target % REWIND_KEYFRAME_INTERVAL) return 0;
+
+    // Presentation keeps its own events, they are not part of the past
+    EventRing events = board->events;
+    *board = key->board;
+    board->events = events;
+
+    u_int pos = key->streamPos;
+    for (int t = key->tick + 1; t <= target; t++) {
+        applyDelta(board, &pos);
+    }
+
+    // The rewound future is discarded
+    for (int i = 0; i < KEYFRAME_COUNT; i++) {
+        if (keyframes[i].tick > target) keyframes[i].tick = -1;
+    }
+    currentTick = target;
+    writePos = pos;
+
+    memcpy(lastScalars, scalarWords(board), sizeof(lastScalars));
+    board->touchedColumns = 0;
+    return ticks;
+}
+
+int Rewind_Budget(void) {
+    return sizeof(keyframes) + sizeof(stream) + sizeof(lastScalars);
+}
@@ -0,0 +1,23 @@
+#ifndef GAME_REWIND_H
+#define GAME_REWIND_H
+
+#include "grid.h"
+
+// Practice mode rewind. A full board is kept every REWIND_KEYFRAME_INTERVAL
+// ticks and, between keyframes, one delta per tick holding only the
+// columns the tick touched and the single values that changed. Seeking
+// restores one keyframe and replays at most one interval of deltas.
+// All memory is static, REWIND_DELTA_BYTES bounds how far back busy play
+// can go.
+#define REWIND_TICKS MS_TO_TICKS(10000)
+#define REWIND_KEYFRAME_INTERVAL MS_TO_TICKS(1000)
+#define REWIND_DELTA_BYTES (32 * 1024) // Power of two
+
+void Rewind_Reset(Board *board);
+void Rewind_Record(Board *board);       // After every tick
+int Rewind_Seek(Board *board, int ticks); // Returns the ticks actually rewound
+
+int Rewind_Available(void); // Ticks that can be rewound right now
+int Rewind_Budget(void);    // Bytes reserved
+
+#endif
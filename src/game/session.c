@@ -1,25 +1,143 @@
 #include "session.h"
 #include "grid.h"
 #include "player.h"
-#include "../core/input.h"
+#include "replay.h"
+#include "checksum.h"
+#include "rewind.h"
+#include "../core/jobs.h"
+#include "../core/perf.h"
+#include "../core/statemanager.h"
+
+static Board board;
+static int replaying = 0;
+static int recording = 0;
+static u_int playedTicks = 0; // Ticks played, a rewind takes them back
+
+static void startGame(int record) {
+    // Build with a fixed seed (make CPPFLAGS+=-DSESSION_SEED=1234) for
+    // reproducible piece sequences, otherwise time on the title screen seeds it
+#ifdef SESSION_SEED
+    u_int seed = SESSION_SEED;
+#else
+    u_int seed = VSync(-1);
+#endif
+
+    Grid_InitGraphics();
+    Grid_Init(&board, seed);
+    Checksum_Reset();
+    Rewind_Reset(&board);
+
+    if(record) Replay_StartRecording(seed);
+    recording = record;
+    replaying = 0;
+    playedTicks = 0;
+}
 
 void GameSession_Init() {
-    Grid_Init();
+    startGame(1);
+}
+
+// CPU demos must not replace the player's last game
+void GameSession_InitDemo() {
+    startGame(0);
+}
+
+void GameSession_InitReplay() {
+    Grid_InitGraphics();
+    Grid_Init(&board, Replay_Get()->seed);
+    Checksum_Reset();
+
+    Replay_StartPlayback();
+    recording = 0;
+    replaying = 1;
 }
 
-void GameSession_Update() {
-    if(Input_IsActionDown(MOVE_LEFT)) Player_MoveLeft();
-    if(Input_IsActionDown(MOVE_RIGHT)) Player_MoveRight();
+void GameSession_Update(int actions) {
+    if(replaying) {
+        // Recorded actions replace the pad, a truncated recording just ends
+        if(!Replay_Next(&actions)) {
+            StateManager_ChangeState(STATE_GAMEOVER);
+            return;
+        }
+    } else if(recording) {
+        Replay_Record(actions);
+    }
+
+    if(actions & ACTION_MOVE_LEFT) Player_MoveLeft(&board);
+    if(actions & ACTION_MOVE_RIGHT) Player_MoveRight(&board);
+
+    if(actions & ACTION_SLAM) Player_SlamBlock(&board);
+    if(actions & ACTION_SLAM_UP) Player_UnlockDrop(&board);
 
-    if(Input_IsActionDown(SLAM)) Player_SlamBlock();
-    if(Input_IsActionUp(SLAM)) Player_UnlockDrop();
+    if(actions & ACTION_ROTATE_CW) Player_RotateCW(&board);
+    if(actions & ACTION_ROTATE_CCW) Player_RotateCCW(&board);
 
-    if(Input_IsActionDown(ROTATE_CW)) Player_RotateCW();
-    if(Input_IsActionDown(ROTATE_CCW)) Player_RotateCCW();
+    Grid_Update(&board);
+    Checksum_Record(Grid_Checksum(&board));
+    if(!replaying) {
+        Rewind_Record(&board);
+        playedTicks++;
+    }
 
-    Grid_Update();
+    GameEvent event;
+    while(Events_Pop(&board.events, &event)) {
+        if(event.type == EVENT_GAME_OVER) {
+#if CHECKSUM_TTY == 1
+            Checksum_Dump();
+#endif
+            StateManager_ChangeState(STATE_GAMEOVER);
+        }
+    }
 }
 
 void GameSession_Draw() {
-    Grid_Draw();
+    Grid_Draw(&board);
+
+    if(replaying) {
+        FntPrint("Replay\n");
+    } else {
+        int available = Rewind_Available();
+        FntPrint("Rewind: %d.%ds (%dKB)\n", available / TICKS_PER_SECOND,
+                 (available % TICKS_PER_SECOND) * 10 / TICKS_PER_SECOND, Rewind_Budget() / 1024);
+    }
+
+    int turbo = System_GetTurbo();
+    if(turbo != TURBO_OFF) {
+        const FrameStats *stats = System_GetFrameStats();
+        if(turbo == TURBO_UNCAPPED) FntPrint("Turbo max ");
+        else FntPrint("Turbo %dx ", turbo);
+        FntPrint("%d ticks/s\n", stats->ticksPerSecond);
+    }
+
+#if PERF_HUD
+    static Board scratch;
+    u_short start = Perf_Now();
+    Grid_Clone(&scratch, &board);
+    FntPrint("Clone: %d bytes %d\n", (int)sizeof(Board), Perf_Since(start));
+
+    const FrameStats *stats = System_GetFrameStats();
+    FntPrint("Ticks: %d Skipped: %d\n", stats->lastTicks, (int)stats->skippedRenders);
+    FntPrint("CPU %d GPU %d lines\n", stats->cpuLines, stats->gpuLines);
+    FntPrint("Waits: CPU %d+%d GPU %d\n", stats->gpuWaitLines, stats->vsyncWaitLines, stats->gpuIdleLines);
+    Jobs_Print();
+#endif
+}
+
+// Practice rewind, the game is paused while it runs
+void GameSession_Rewind(int ticks) {
+    if(replaying) return;
+
+    int rewound = Rewind_Seek(&board, ticks);
+    playedTicks -= rewound;
+
+    // What the replay holds from here on never happened
+    if(rewound && recording) Replay_Truncate(playedTicks);
+}
+
+int GameSession_IsReplay() {
+    return replaying;
+}
+
+const Board *GameSession_GetBoard() {
+    return &board;
 }
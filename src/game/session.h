@@ -1,8 +1,25 @@
 #ifndef GAME_SESSION_H
 #define GAME_SESSION_H
 
-void GameSession_Init(void);
-void GameSession_Update(void);
+#include "grid.h"
+
+// Player actions for one tick. This is everything the game reads from the
+// pad, so a seed and these bits per tick reproduce a game exactly.
+#define ACTION_MOVE_LEFT   0x01
+#define ACTION_MOVE_RIGHT  0x02
+#define ACTION_SLAM        0x04
+#define ACTION_SLAM_UP     0x08
+#define ACTION_ROTATE_CW   0x10
+#define ACTION_ROTATE_CCW  0x20
+
+void GameSession_Init(void);       // New game, recorded
+void GameSession_InitDemo(void);   // New game that leaves the recording alone
+void GameSession_InitReplay(void); // Plays back the last recorded game
+void GameSession_Update(int actions);
+void GameSession_Rewind(int ticks);
 void GameSession_Draw(void);
 
+int GameSession_IsReplay(void);
+const Board *GameSession_GetBoard(void);
+
 #endif
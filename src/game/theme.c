@@ -1,21 +1,21 @@
 #include "theme.h"
 
 const Theme THEME_LIBRARY[] = {
-    { "Vaporwave", {255,105,180}, {0,255,255},   {199,20,133}, {0,139,139} },
-    { "Sunset",    {255,165,0},   {147,112,219}, {200,80,0},   {75,0,130} },
-    { "Forest",    {220,20,60},   {154,205,50},  {139,0,0},    {85,107,47} },
-    { "Arcade",    {255,50,50},   {50,100,255},  {150,0,0},    {0,0,139} },
-    { "Citrus",    {50,205,50},   {255,215,0},   {0,100,0},    {184,134,11} },
-    { "Pastel",    {152,251,152}, {221,160,221}, {46,139,87},  {128,0,128} },
-    { "Industrial",{210,105,30},  {176,196,222}, {139,69,19},  {70,130,180} },
-    { "Candy",     {255,127,80},  {64,224,208},  {178,34,34},  {0,128,128} },
-    { "Royal",     {238,232,170}, {65,105,225},  {184,134,11}, {25,25,112} },
-    { "Halloween", {255,140,0},   {127,255,0},   {100,50,0},   {60,120,0} },
-    { "Arctic",    {224,255,255}, {70,130,180},  {95,158,160}, {25,25,112} },
-    { "Terminal",  {255,191,0},   {0,255,65},    {139,69,0},   {0,100,0} },
-    { "Coffee",    {245,222,179}, {210,180,140}, {160,82,45},  {101,67,33} },
-    { "Electric",  {138,43,226},  {200,255,0},   {75,0,130},   {100,128,0} },
-    { "Rose Sky",  {255,182,193}, {135,206,235}, {219,112,147},{70,130,180} }
+    { "Vaporwave", {255,105,180}, {0,255,255},   {199,20,133}, {0,139,139},  100 },
+    { "Sunset",    {255,165,0},   {147,112,219}, {200,80,0},   {75,0,130},   110 },
+    { "Forest",    {220,20,60},   {154,205,50},  {139,0,0},    {85,107,47},  116 },
+    { "Arcade",    {255,50,50},   {50,100,255},  {150,0,0},    {0,0,139},    128 },
+    { "Citrus",    {50,205,50},   {255,215,0},   {0,100,0},    {184,134,11}, 124 },
+    { "Pastel",    {152,251,152}, {221,160,221}, {46,139,87},  {128,0,128},   96 },
+    { "Industrial",{210,105,30},  {176,196,222}, {139,69,19},  {70,130,180}, 132 },
+    { "Candy",     {255,127,80},  {64,224,208},  {178,34,34},  {0,128,128},  126 },
+    { "Royal",     {238,232,170}, {65,105,225},  {184,134,11}, {25,25,112},  112 },
+    { "Halloween", {255,140,0},   {127,255,0},   {100,50,0},   {60,120,0},   138 },
+    { "Arctic",    {224,255,255}, {70,130,180},  {95,158,160}, {25,25,112},  120 },
+    { "Terminal",  {255,191,0},   {0,255,65},    {139,69,0},   {0,100,0},    136 },
+    { "Coffee",    {245,222,179}, {210,180,140}, {160,82,45},  {101,67,33},   92 },
+    { "Electric",  {138,43,226},  {200,255,0},   {75,0,130},   {100,128,0},  144 },
+    { "Rose Sky",  {255,182,193}, {135,206,235}, {219,112,147},{70,130,180}, 104 }
 };
 
 const int TOTAL_THEMES = sizeof(THEME_LIBRARY) / sizeof(Theme);
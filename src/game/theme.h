@@ -10,6 +10,7 @@ typedef struct {
     CVECTOR block_b;
     CVECTOR block_a_dark;
     CVECTOR block_b_dark;
+    short bpm; // Timeline tempo of the skin
 } Theme;
 
 // Expose the library and count
@@ -1,6 +1,16 @@
 #include "core/statemanager.h"
 #include "core/system.h"
 #include "core/input.h"
+#include "core/jobs.h"
+
+static void runTick(void)
+{
+    Input_Update();
+
+    StateManager_Update();
+
+    System_CountTick();
+}
 
 int main(void)
 {
@@ -12,9 +22,28 @@ int main(void)
 
     while (1)
     {
-        Input_Update();
+        // Simulation runs at a fixed rate, a slow frame just skips renders
+        int ticks = System_WaitTicks();
+        int turbo = System_GetTurbo();
+
+        if (turbo == TURBO_UNCAPPED)
+        {
+            // Fill the time until the next frame with logic
+            do runTick(); while (!System_FrameDue());
+        }
+        else
+        {
+            int steps = ticks * turbo;
+            while (steps--) runTick();
+        }
+
+        StateManager_Draw();
+
+        System_Display();
 
-        StateManager_Update();
+        // The GPU is drawing, spare time before the next frame goes to
+        // background jobs
+        Jobs_Run();
     }
     return 0;
 }
@@ -1,17 +1,88 @@
 #include "arcade.h"
 #include "../game/session.h"
+#include "../game/opponent.h"
+#include "../core/input.h"
 #include "../core/system.h"
+#include "../core/statemanager.h"
+
+// SELECT cycles through these
+static const int TURBO_MODES[] = {TURBO_OFF, 4, 16, TURBO_UNCAPPED};
+#define TURBO_MODE_COUNT (sizeof(TURBO_MODES) / sizeof(TURBO_MODES[0]))
+
+static void cycleTurbo(void) {
+    int turbo = System_GetTurbo();
+    int next = 0;
+
+    for (int i = 0; i < TURBO_MODE_COUNT; i++) {
+        if (TURBO_MODES[i] == turbo) next = (i + 1) % TURBO_MODE_COUNT;
+    }
+    System_SetTurbo(TURBO_MODES[next]);
+}
+
+#define REWIND_SPEED 2 // Ticks stepped back per tick while REWIND is held
+
+static int attract = 0; // The CPU plays until a button is pressed
+
+static int readActions(void) {
+    int actions = 0;
+
+    if(Input_IsActionDown(MOVE_LEFT)) actions |= ACTION_MOVE_LEFT;
+    if(Input_IsActionDown(MOVE_RIGHT)) actions |= ACTION_MOVE_RIGHT;
+
+    if(Input_IsActionDown(SLAM)) actions |= ACTION_SLAM;
+    if(Input_IsActionUp(SLAM)) actions |= ACTION_SLAM_UP;
+
+    if(Input_IsActionDown(ROTATE_CW)) actions |= ACTION_ROTATE_CW;
+    if(Input_IsActionDown(ROTATE_CCW)) actions |= ACTION_ROTATE_CCW;
+
+    return actions;
+}
 
 void StateArcade_Init() {
     GameSession_Init();
+    attract = 0;
+}
+
+void StateArcade_InitReplay() {
+    GameSession_InitReplay();
+    attract = 0;
+}
+
+void StateArcade_InitAttract() {
+    GameSession_InitDemo();
+    Opponent_Init(OPPONENT_NORMAL);
+    attract = 1;
 }
 
 void StateArcade_Update() {
-    GameSession_Update();
+    // Turbo is not part of the game, it is never recorded
+    if(Input_IsActionDown(TURBO)) cycleTurbo();
 
+    if(attract) {
+        if(Input_IsActionUp(CONFIRM)) {
+            StateManager_ChangeState(STATE_TITLE);
+            return;
+        }
+        GameSession_Update(Opponent_Update(GameSession_GetBoard()));
+        return;
+    }
+
+    if(Input_IsActionHeld(REWIND) && !GameSession_IsReplay()) {
+        GameSession_Rewind(REWIND_SPEED);
+        return;
+    }
+
+    GameSession_Update(readActions());
+}
+
+void StateArcade_Draw() {
     System_ClearOT();
     GameSession_Draw();
-    System_Display();
+    if(attract) FntPrint("Demo, press X or START\n");
 }
 
-void StateArcade_Exit() {}
+void StateArcade_Exit() {
+    if(attract) Opponent_Stop();
+    System_SetClear(1); // Other screens do not draw the backdrop
+    System_SetTurbo(TURBO_OFF); // Menu timers count real ticks
+}
@@ -2,7 +2,10 @@
 #define STATES_ARCADE_H
 
 void StateArcade_Init(void);
+void StateArcade_InitReplay(void);
+void StateArcade_InitAttract(void);
 void StateArcade_Update(void);
+void StateArcade_Draw(void);
 void StateArcade_Exit(void);
 
 #endif
@@ -4,6 +4,10 @@
 #include "../core/statemanager.h"
 #include "libgpu.h"
 #include "../game/grid.h"
+#include "../game/session.h"
+#include "../game/replay.h"
+
+#define WARMUP_TICKS MS_TO_TICKS(500)
 
 static int titleFrameCount = 0;
 
@@ -14,17 +18,19 @@ void StateGameover_Init() {
 void StateGameover_Update() {
     titleFrameCount++;
 
-    if(titleFrameCount > 30) { // Accept inputs after half second warmup
+    if(titleFrameCount > WARMUP_TICKS) { // Accept inputs after a short warmup
         if (Input_IsActionUp(CONFIRM)) StateManager_ChangeState(STATE_TITLE);
+        if (Input_IsActionUp(CANCEL)) StateManager_ChangeState(STATE_REPLAY);
     }
+}
 
+void StateGameover_Draw() {
     System_ClearOT();
 
     FntPrint("Game over!\n");
-    FntPrint("Your score: %d\n\n", GetScore());
-    FntPrint("Press X or START to return to title");
-
-    System_Display();
+    FntPrint("Your score: %d\n\n", GetScore(GameSession_GetBoard()));
+    FntPrint("Press X or START to return to title\n");
+    FntPrint("Press TRIANGLE to watch the replay (%d bytes)", Replay_Size());
 }
 
 void StateGameover_Exit() {}
@@ -3,6 +3,7 @@
 
 void StateGameover_Init(void);
 void StateGameover_Update(void);
+void StateGameover_Draw(void);
 void StateGameover_Exit(void);
 
 #endif
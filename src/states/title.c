@@ -4,6 +4,9 @@
 #include "../core/statemanager.h"
 #include "libgpu.h"
 
+#define WARMUP_TICKS MS_TO_TICKS(500)
+#define ATTRACT_TICKS MS_TO_TICKS(15000) // Idle time before the CPU plays a demo
+
 static int titleFrameCount = 0;
 
 void StateTitle_Init() {
@@ -13,17 +16,21 @@ void StateTitle_Init() {
 void StateTitle_Update() {
     titleFrameCount++;
 
-    if(titleFrameCount > 30) { // Accept inputs after half second warmup
+    if(titleFrameCount > WARMUP_TICKS) { // Accept inputs after a short warmup
         if (Input_IsActionUp(CONFIRM)) StateManager_ChangeState(STATE_ARCADE);
     }
 
+    if(titleFrameCount > ATTRACT_TICKS) {
+        StateManager_ChangeState(STATE_ATTRACT);
+    }
+}
+
+void StateTitle_Draw() {
     System_ClearOT();
 
     FntPrint("Lumines PSX\n");
     FntPrint("WIP Title Screen\n\n");
     FntPrint("Press X or START");
-
-    System_Display();
 }
 
 void StateTitle_Exit() {}
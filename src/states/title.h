@@ -3,6 +3,7 @@
 
 void StateTitle_Init(void);
 void StateTitle_Update(void);
+void StateTitle_Draw(void);
 void StateTitle_Exit(void);
 
 #endif